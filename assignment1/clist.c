@@ -0,0 +1,287 @@
+/*
+ * This file contains the implementation of a lock-free sorted linked list,
+ * following the algorithm of Harris (with Michael's changes for safe memory
+ * reclamation).  Any number of threads may call clist_insert(),
+ * clist_remove() and clist_contains() on the same list at the same time.
+ *
+ * Nodes are removed in two steps.  First the node is *logically* deleted by
+ * setting a mark in the lowest bit of its `next` pointer, which stops any
+ * other thread from linking a node after it.  Then it is *physically*
+ * unlinked with a compare-and-swap on its predecessor, either by the removing
+ * thread or by whichever thread next walks past it.  Unlinked nodes are freed
+ * through epoch-based reclamation (see epoch.c), since other threads may still
+ * be reading them.
+ *
+ * Like list_sort(), the functions here are passed a *function pointer* called
+ * `cmp` that orders two values: it should return a negative value if `a`
+ * comes before `b`, 0 if they are equal, and a positive value if `a` comes
+ * after `b`.  The same `cmp` must be used for every call on a given list.
+ *
+ * Name: Gabriel de Leon
+ * Email: deleong@oregonstate.edu
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+
+#include "clist.h"
+#include "epoch.h"
+
+/*
+ * This structure is used to represent a single node in a concurrent list.
+ * The lowest bit of `next` is set once the node has been logically deleted.
+ */
+struct clist_node {
+    void* val;
+    struct clist_node* next;
+};
+
+/*
+ * This structure is used to represent an entire concurrent list.  `head` is a
+ * sentinel node that doesn't hold a value, so every real node has a
+ * predecessor whose `next` pointer can be swapped.
+ */
+struct clist {
+    struct clist_node head;
+};
+
+/*
+ * These functions set, clear and test the deletion mark on a `next` pointer.
+ */
+static struct clist_node* mark(struct clist_node* node)
+{
+    return (struct clist_node*)((uintptr_t)node | 1);
+}
+
+static struct clist_node* unmark(struct clist_node* node)
+{
+    return (struct clist_node*)((uintptr_t)node & ~(uintptr_t)1);
+}
+
+static int is_marked(struct clist_node* node)
+{
+    return ((uintptr_t)node & 1) != 0;
+}
+
+/*
+ * This function frees a node once epoch reclamation says it's safe.
+ */
+static void clist_node_free(void* node)
+{
+    free(node);
+}
+
+/*
+ * This function finds the first node whose value is not less than `val`,
+ * along with the `next` field of the node before it.  Any logically deleted
+ * nodes passed on the way are unlinked and retired.  It must be called from
+ * inside an epoch critical section.
+ *
+ * Params:
+ * list - the list to be searched.
+ * val - the value to search for.
+ * cmp - pointer to a function that orders two void* values.
+ * prev - set to point to the `next` field that points to the returned node.
+ *
+ * Return:
+ *   Returns the first unmarked node whose value is not less than `val`, or
+ *   NULL if there is no such node.
+ */
+static struct clist_node* find(struct clist* list, void* val, int (*cmp)(void* a, void* b), struct clist_node*** prev)
+{
+retry:
+    *prev = &list->head.next;
+    struct clist_node* curr = __atomic_load_n(*prev, __ATOMIC_ACQUIRE);
+
+    while(curr != NULL) {
+
+        struct clist_node* next = __atomic_load_n(&curr->next, __ATOMIC_ACQUIRE);
+
+        //the predecessor changed under us, so the walk starts over
+        if(__atomic_load_n(*prev, __ATOMIC_ACQUIRE) != curr) {
+            goto retry;
+        }
+
+        //helps unlink a node that another thread logically deleted
+        if(is_marked(next)) {
+            if(!__atomic_compare_exchange_n(*prev, &curr, unmark(next), 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+                goto retry;
+            }
+            epoch_retire(curr, clist_node_free);
+            curr = unmark(next);
+            continue;
+        }
+
+        if(cmp(curr->val, val) >= 0) {
+            return curr;
+        }
+
+        *prev = &curr->next;
+        curr = next;
+    }
+
+    return NULL;
+}
+
+/*
+ * This function should allocate and initialize a new, empty concurrent list
+ * and return a pointer to it.
+ */
+struct clist* clist_create()
+{
+    struct clist* list = malloc(sizeof(struct clist));
+    list->head.val = NULL;
+    list->head.next = NULL;
+
+    return list;
+}
+
+/*
+ * This function frees the memory associated with a concurrent list.  Like
+ * list_free(), it does not free the values stored in the list.  No other
+ * thread may be using the list when it is freed.  Nodes that were already
+ * removed are freed by epoch reclamation (see epoch_flush()).
+ *
+ * Params:
+ * list - the list to be destroyed.  May not be NULL.
+ */
+void clist_free(struct clist* list)
+{
+    assert(list);
+
+    struct clist_node* current = unmark(list->head.next);
+    while(current != NULL) {
+        struct clist_node* temp = current;
+        current = unmark(current->next);
+        free(temp);
+    }
+
+    free(list);
+}
+
+/*
+ * This function inserts a value into a concurrent list, keeping the list
+ * sorted.  The value is placed before any equal values already in the list.
+ * This function never blocks.
+ *
+ * Params:
+ * list - the list into which to insert a value.  May not be NULL.
+ * val - the value to be inserted.
+ * cmp - pointer to a function that orders two void* values.
+ */
+void clist_insert(struct clist* list, void* val, int (*cmp)(void* a, void* b))
+{
+    assert(list);
+
+    struct clist_node* node = malloc(sizeof(struct clist_node));
+    node->val = val;
+
+    epoch_enter();
+
+    //links the node in front of its successor, retrying if the link moved
+    while(1) {
+        struct clist_node** prev;
+        struct clist_node* curr = find(list, val, cmp, &prev);
+
+        node->next = curr;
+        if(__atomic_compare_exchange_n(prev, &curr, node, 0, __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+
+    epoch_exit();
+}
+
+/*
+ * This function removes the first instance of a value from a concurrent list
+ * and frees the node that held it (but not the value itself).  This function
+ * never blocks.
+ *
+ * Params:
+ * list - the list from which to remove a value.  May not be NULL.
+ * val - the value to be removed.
+ * cmp - pointer to a function that orders two void* values.
+ *
+ * Return:
+ *   Returns 1 if this call removed a value, or 0 if `val` wasn't in the list.
+ */
+int clist_remove(struct clist* list, void* val, int (*cmp)(void* a, void* b))
+{
+    assert(list);
+
+    int removed = 0;
+
+    epoch_enter();
+
+    while(1) {
+        struct clist_node** prev;
+        struct clist_node* curr = find(list, val, cmp, &prev);
+
+        if(curr == NULL || cmp(curr->val, val) != 0) {
+            break;
+        }
+
+        //logically deletes the node by marking its next pointer
+        struct clist_node* next = __atomic_load_n(&curr->next, __ATOMIC_ACQUIRE);
+        if(is_marked(next) || !__atomic_compare_exchange_n(&curr->next, &next, mark(next), 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+            continue;
+        }
+        removed = 1;
+
+        //physically unlinks it, or leaves that to the next find() if we lose
+        if(__atomic_compare_exchange_n(prev, &curr, next, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+            epoch_retire(curr, clist_node_free);
+        }
+        else {
+            find(list, val, cmp, &prev);
+        }
+
+        break;
+    }
+
+    epoch_exit();
+
+    return removed;
+}
+
+/*
+ * This function checks whether a concurrent list contains a value.  It only
+ * reads the list, so it never writes to shared memory and never blocks.
+ *
+ * Params:
+ * list - the list to be searched.  May not be NULL.
+ * val - the value to be located.
+ * cmp - pointer to a function that orders two void* values.
+ *
+ * Return:
+ *   Returns 1 if the list contains a value equal to `val`, or 0 otherwise.
+ */
+int clist_contains(struct clist* list, void* val, int (*cmp)(void* a, void* b))
+{
+    assert(list);
+
+    int found = 0;
+
+    epoch_enter();
+
+    //walks past smaller values, ignoring deletion marks along the way
+    struct clist_node* curr = unmark(__atomic_load_n(&list->head.next, __ATOMIC_ACQUIRE));
+    while(curr != NULL && cmp(curr->val, val) < 0) {
+        curr = unmark(__atomic_load_n(&curr->next, __ATOMIC_ACQUIRE));
+    }
+
+    //an equal value only counts if its node hasn't been deleted
+    while(curr != NULL && cmp(curr->val, val) == 0) {
+        struct clist_node* next = __atomic_load_n(&curr->next, __ATOMIC_ACQUIRE);
+        if(!is_marked(next)) {
+            found = 1;
+            break;
+        }
+        curr = unmark(next);
+    }
+
+    epoch_exit();
+
+    return found;
+}
@@ -0,0 +1,26 @@
+/*
+ * This file contains the definition of the interface for a concurrent sorted
+ * linked list that many threads can use at the same time without locks.  You
+ * can find descriptions of the concurrent list functions, including their
+ * parameters and their return values, in clist.c.
+ */
+
+#ifndef __CLIST_H
+#define __CLIST_H
+
+/*
+ * Structure used to represent a concurrent sorted linked list.
+ */
+struct clist;
+
+/*
+ * Concurrent linked list interface function prototypes.  Refer to clist.c for
+ * documentation about each of these functions.
+ */
+struct clist* clist_create();
+void clist_free(struct clist* list);
+void clist_insert(struct clist* list, void* val, int (*cmp)(void* a, void* b));
+int clist_remove(struct clist* list, void* val, int (*cmp)(void* a, void* b));
+int clist_contains(struct clist* list, void* val, int (*cmp)(void* a, void* b));
+
+#endif
@@ -189,3 +189,33 @@ void dynarray_set(struct dynarray* da, int idx, void* val)
     da->data[idx] = val;
     return; 
 }
+
+/*
+ * This function makes sure a dynamic array has room for at least `capacity`
+ * elements, so that that many elements can be inserted without the array
+ * having to grow again.  If the array is already big enough, nothing happens.
+ *
+ * Params:
+ *   da - the dynamic array whose capacity is to be increased.  May not be
+ *     NULL.
+ *   capacity - the number of elements the array should be able to hold.
+ */
+void dynarray_reserve(struct dynarray* da, int capacity)
+{
+    //checks if the array is already big enough
+    if(capacity <= da->capacity) {
+        return;
+    }
+
+    //makes a new array and moves the old values into it
+    void** temp = malloc(sizeof(void*) * capacity);
+    for(int i = 0; i < da->size; i++) {
+        temp[i] = da->data[i];
+    }
+
+    free(da->data);
+    da->data = temp;
+    da->capacity = capacity;
+
+    return;
+}
@@ -24,5 +24,6 @@ void dynarray_insert(struct dynarray* da, void* val);
 void dynarray_remove(struct dynarray* da, int idx);
 void* dynarray_get(struct dynarray* da, int idx);
 void dynarray_set(struct dynarray* da, int idx, void* val);
+void dynarray_reserve(struct dynarray* da, int capacity);
 
 #endif
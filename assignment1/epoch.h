@@ -0,0 +1,20 @@
+/*
+ * This file contains the definition of the interface for epoch-based memory
+ * reclamation, which lets lock-free data structures free nodes that other
+ * threads might still be reading.  You can find descriptions of the epoch
+ * functions, including their parameters and their return values, in epoch.c.
+ */
+
+#ifndef __EPOCH_H
+#define __EPOCH_H
+
+/*
+ * Epoch-based reclamation interface function prototypes.  Refer to epoch.c
+ * for documentation about each of these functions.
+ */
+void epoch_enter();
+void epoch_exit();
+void epoch_retire(void* ptr, void (*free_fn)(void* ptr));
+void epoch_flush();
+
+#endif
@@ -10,8 +10,10 @@
  */
 
 #include <stdlib.h>
+#include <stddef.h>
 #include <assert.h>
 #include "list.h"
+#include "dynarray.h"
 
 /*
  * This structure is used to represent a single node in a singly-linked list.
@@ -24,15 +26,96 @@ struct node
     struct node* next;
 };
 
+/*
+ * This structure is used to hold a node along with the block it was allocated
+ * in, or NULL if it was allocated on its own.  Every node lives in one of
+ * these, so a node's origin can be found from the node itself when it's
+ * freed.
+ */
+struct node_slot
+{
+    struct node_block* block;
+    struct node node;
+};
+
+/*
+ * This structure is used to represent a block of nodes that were allocated
+ * together with a single call to malloc() by one of the bulk conversions.
+ * `live` is the number of the block's nodes that are still in a list; the
+ * block is freed when it reaches 0.
+ */
+struct node_block
+{
+    int live;
+    struct node_slot slots[];
+};
+
 /*
  * This structure is used to represent an entire singly-linked list. Note that
  * we're keeping track of just the head of the list here, for simplicity.
+ *
+ * Nodes added one at a time are allocated one at a time, but the bulk
+ * conversions (list_from_array() and dynarray_to_list()) allocate all of
+ * their nodes in one block.
  */
 struct list
 {
     struct node* head;
 };
 
+/*
+ * This function allocates a node for a single insert.
+ */
+static struct node* node_alloc()
+{
+    struct node_slot* slot = malloc(sizeof(struct node_slot));
+    slot->block = NULL;
+    return &slot->node;
+}
+
+/*
+ * This function frees a node that was removed from a list.  A node from a
+ * block just counts against its block, and the block is freed along with the
+ * last of its nodes.
+ */
+static void node_release(struct node* node)
+{
+    struct node_slot* slot = (struct node_slot*)((char*)node - offsetof(struct node_slot, node));
+
+    if(slot->block == NULL) {
+        free(slot);
+    }
+    else if(--slot->block->live == 0) {
+        free(slot->block);
+    }
+}
+
+/*
+ * This function allocates `n` nodes for a list with a single call to malloc()
+ * and links them together in order, storing the values returned by
+ * `get(src, i)` in them.  The new chain is placed in front of whatever the
+ * list already contains.
+ */
+static void node_fill(struct list* list, int n, void* (*get)(void* src, int i), void* src)
+{
+    if(n <= 0) {
+        return;
+    }
+
+    struct node_block* block = malloc(sizeof(struct node_block) + n * sizeof(struct node_slot));
+    block->live = n;
+
+    //links each node to the one after it in the block
+    for(int i = 0; i < n; i++) {
+        block->slots[i].block = block;
+        block->slots[i].node.val = get(src, i);
+        block->slots[i].node.next = &block->slots[i + 1].node;
+    }
+
+    block->slots[n - 1].node.next = list->head;
+    list->head = &block->slots[0].node;
+}
+
 /*
  * This function should allocate and initialize a new, empty linked list and
  * return a pointer to it.
@@ -59,12 +142,13 @@ struct list* list_create()
 
 void list_free(struct list* list)
 {
-    //goes through each node in the list and clears each one of them
+    //goes through each node in the list and clears each one of them; the
+    //last node from a block frees the block
     while(list->head != NULL) {
         
         struct node* temp = list->head;
         list->head = list->head->next;
-        free(temp);
+        node_release(temp);
     }
     
     //clears the list itself
@@ -90,7 +174,7 @@ void list_free(struct list* list)
 void list_insert(struct list* list, void* val)
 {   
     //allocates a new node
-    struct node* temp = malloc(sizeof(struct node));
+    struct node* temp = node_alloc();
     temp->val = val;
 
     //new node becomes the head here
@@ -118,7 +202,7 @@ void list_insert_end(struct list* list, void* val)
 {
     //allocates new node and keeps track of the head
     struct node* temp = list->head;
-    struct node* new_node = malloc(sizeof(struct node));
+    struct node* new_node = node_alloc();
     new_node->val = val;
     new_node->next = NULL;
 
@@ -191,7 +275,7 @@ void list_remove(struct list* list, void* val, int (*cmp)(void* a, void* b))
     if(cmp(val, list->head->val) == 0) {
 
         list->head = temp->next;
-        free(temp);
+        node_release(temp);
         temp = NULL;
         return;
     }
@@ -204,7 +288,7 @@ void list_remove(struct list* list, void* val, int (*cmp)(void* a, void* b))
 
             //the previous node is wired to skip the removed node and go to the next one
             prev->next = list->head->next;
-            free(list->head);
+            node_release(list->head);
             list->head = temp;
             return; 
         }
@@ -240,7 +324,7 @@ void list_remove_end(struct list* list)
     //if there's only one element in the list
     if(list->head->next == NULL) {
         
-        free(list->head);
+        node_release(list->head);
         list->head = NULL;
         return;
     }
@@ -255,7 +339,7 @@ void list_remove_end(struct list* list)
     }
 
     //removes last node in the list
-    free(list->head);
+    node_release(list->head);
     prev->next = NULL;
 
     list->head = temp;
@@ -264,6 +348,98 @@ void list_remove_end(struct list* list)
 }
 
 
+/*
+ * This structure holds the value and comparison function that
+ * list_remove_all() passes to list_filter() as its context.
+ */
+struct remove_all_ctx
+{
+    void* val;
+    int (*cmp)(void* a, void* b);
+};
+
+/*
+ * This function is the predicate list_remove_all() uses with list_filter().
+ * It matches every value equal to the one in the context.
+ */
+static int remove_all_pred(void* val, void* ctx)
+{
+    struct remove_all_ctx* rc = ctx;
+    return rc->cmp(rc->val, val) == 0;
+}
+
+/*
+ * This function removes *every* element with a specified value from a given
+ * linked list, in a single pass through the list (unlike list_remove(), which
+ * only removes the first one).  The `cmp` function is used just like in
+ * list_remove().
+ *
+ * Params:
+ * list - the linked list from which to remove elements.  May not be NULL.
+ * val - the value to be removed.
+ * cmp - pointer to a function that can be passed two void* values to compare
+ *     them for equality, as described in list_remove().
+ * free_val - if not NULL, this function is called on each removed value so
+ *     that the caller can free it.
+ *
+ * Return:
+ *   Returns the number of elements that were removed.
+ */
+int list_remove_all(struct list* list, void* val, int (*cmp)(void* a, void* b), void (*free_val)(void* val))
+{
+    struct remove_all_ctx ctx;
+    ctx.val = val;
+    ctx.cmp = cmp;
+
+    return list_filter(list, remove_all_pred, &ctx, free_val);
+}
+
+/*
+ * This function removes every element of a given linked list for which a
+ * predicate function returns a non-zero value, in a single pass through the
+ * list.  The remaining elements keep their order.
+ *
+ * Params:
+ * list - the linked list from which to remove elements.  May not be NULL.
+ * pred - pointer to a function that is passed each value in the list along
+ *     with `ctx`.  It should return a non-zero value if the value is to be
+ *     removed and 0 if it is to be kept.
+ * ctx - an extra pointer passed through to `pred`.  May be NULL.
+ * free_val - if not NULL, this function is called on each removed value so
+ *     that the caller can free it.
+ *
+ * Return:
+ *   Returns the number of elements that were removed.
+ */
+int list_filter(struct list* list, int (*pred)(void* val, void* ctx), void* ctx, void (*free_val)(void* val))
+{
+    //points at the link that leads to the node currently being looked at
+    struct node** link = &list->head;
+    int removed = 0;
+
+    while(*link != NULL) {
+
+        struct node* current = *link;
+
+        //unlinks the node and stays on the same link for the next node
+        if(pred(current->val, ctx)) {
+            *link = current->next;
+            if(free_val != NULL) {
+                free_val(current->val);
+            }
+            node_release(current);
+            removed++;
+        }
+
+        //keeps the node and moves on to its link
+        else {
+            link = &current->next;
+        }
+    }
+
+    return removed;
+}
+
 /*
  * This function should return the position (i.e. the 0-based "index") of the
  * first instance of a specified value within a given linked list. For
@@ -365,3 +541,237 @@ void list_reverse(struct list* list)
 
     return;
 }
+
+/*
+ * This function merges two already-sorted chains of nodes into a single sorted
+ * chain by relinking the existing nodes.  No memory is allocated.  When two
+ * values compare as equal, the one from `a` is placed first, so the merge is
+ * stable.
+ *
+ * Params:
+ * a - the head of the first sorted chain.  May be NULL.
+ * b - the head of the second sorted chain.  May be NULL.
+ * cmp - pointer to a function that orders two void* values, as described in
+ *     list_sort() below.
+ * tail - if not NULL, set to point to the last node of the merged chain.
+ *
+ * Return:
+ *   Returns the head of the merged chain.
+ */
+static struct node* merge_nodes(struct node* a, struct node* b, int (*cmp)(void* a, void* b), struct node** tail)
+{
+    struct node dummy;
+    struct node* last = &dummy;
+
+    //repeatedly moves the smaller front node onto the end of the merged chain
+    while(a != NULL && b != NULL) {
+
+        if(cmp(b->val, a->val) < 0) {
+            last->next = b;
+            b = b->next;
+        }
+
+        else {
+            last->next = a;
+            a = a->next;
+        }
+
+        last = last->next;
+    }
+
+    //whatever is left over is already sorted, so it's attached as is
+    last->next = (a != NULL) ? a : b;
+
+    if(tail != NULL) {
+        while(last->next != NULL) {
+            last = last->next;
+        }
+        *tail = last;
+    }
+
+    return dummy.next;
+}
+
+/*
+ * This function sorts a given linked list in place using a bottom-up merge
+ * sort.  Nodes are relinked rather than copied, so no memory is allocated, and
+ * there is no recursion, so long lists can't overflow the stack.  The sort
+ * runs in O(n log n) time and is stable (equal values keep their relative
+ * order).
+ *
+ * The list is sorted in ascending order according to the function pointer
+ * `cmp`.  Unlike the equality comparison used by list_remove() and
+ * list_position(), here `cmp` must say how its two arguments are *ordered*:
+ * it should return a negative value if `a` comes before `b`, 0 if they are
+ * equal, and a positive value if `a` comes after `b` (just like the comparison
+ * functions passed to qsort()).
+ *
+ * Params:
+ * list - the linked list to be sorted.  May not be NULL.
+ * cmp - pointer to a function that orders two void* values, as described
+ *     above.
+ */
+void list_sort(struct list* list, int (*cmp)(void* a, void* b))
+{
+    struct node* rest;
+    struct node* tail;
+    struct node dummy;
+    int width = 1;
+    int merges;
+
+    //runs of length `width` are merged pairwise until a single run is left
+    do {
+        rest = list->head;
+        tail = &dummy;
+        merges = 0;
+
+        while(rest != NULL) {
+
+            struct node* a = rest;
+            struct node* b;
+            struct node* last;
+            int i;
+
+            //cuts the first run of up to `width` nodes
+            for(i = 1; i < width && rest->next != NULL; i++) {
+                rest = rest->next;
+            }
+            b = rest->next;
+            rest->next = NULL;
+            rest = b;
+
+            //cuts the second run of up to `width` nodes
+            if(rest != NULL) {
+                for(i = 1; i < width && rest->next != NULL; i++) {
+                    rest = rest->next;
+                }
+                struct node* next = rest->next;
+                rest->next = NULL;
+                rest = next;
+            }
+
+            //merges the two runs and attaches the result to the sorted part
+            tail->next = merge_nodes(a, b, cmp, &last);
+            tail = last;
+            merges++;
+        }
+
+        tail->next = NULL;
+        list->head = dummy.next;
+        width *= 2;
+
+    } while(merges > 1);
+
+    return;
+}
+
+/*
+ * This function merges two sorted linked lists.  All of the nodes from `other`
+ * are moved into `list` so that `list` stays sorted, and `other` is left
+ * empty (it still needs to be freed by the caller with list_free()).  Nodes
+ * are relinked rather than copied, so no memory is allocated, and the merge
+ * runs in O(n + m) time.  When values compare as equal, the ones already in
+ * `list` are placed first.
+ *
+ * Params:
+ * list - a linked list sorted according to `cmp`.  May not be NULL.  When this
+ *     function returns this will contain the values of both lists.
+ * other - another linked list sorted according to `cmp`.  May not be NULL.
+ *     When this function returns this will be empty.
+ * cmp - pointer to a function that orders two void* values, as described in
+ *     list_sort() above.
+ */
+void list_merge(struct list* list, struct list* other, int (*cmp)(void* a, void* b))
+{
+    list->head = merge_nodes(list->head, other->head, cmp, NULL);
+    other->head = NULL;
+
+    return;
+}
+
+/*
+ * These functions fetch the value at index `i` from a plain array and from a
+ * dynamic array, for use with node_fill().
+ */
+static void* array_get(void* src, int i)
+{
+    return ((void**)src)[i];
+}
+
+static void* dynarray_get_value(void* src, int i)
+{
+    return dynarray_get(src, i);
+}
+
+/*
+ * This function allocates a new linked list holding the values of an array,
+ * in the same order.  All of the nodes are allocated together with a single
+ * call to malloc(), so this is much faster than calling list_insert_end() for
+ * each value.
+ *
+ * Params:
+ * vals - the values to be stored in the list.  May be NULL if `n` is 0.
+ * n - the number of values in `vals`.
+ *
+ * Return:
+ *   Returns a new list whose first node holds vals[0], whose second node
+ *   holds vals[1], and so forth.
+ */
+struct list* list_from_array(void** vals, int n)
+{
+    struct list* list = list_create();
+    node_fill(list, n, array_get, vals);
+
+    return list;
+}
+
+/*
+ * This function allocates a new dynamic array holding the values of a linked
+ * list, in the same order.  The array's storage is sized for the whole list
+ * up front, so it is allocated only once.
+ *
+ * Params:
+ * list - the linked list whose values are to be copied.  May not be NULL.
+ *
+ * Return:
+ *   Returns a new dynamic array whose element 0 is the value at the head of
+ *   the list, whose element 1 is the next value, and so forth.
+ */
+struct dynarray* list_to_dynarray(struct list* list)
+{
+    struct dynarray* da = dynarray_create();
+    struct node* current;
+    int n = 0;
+
+    //counts the nodes so the array only needs to grow once
+    for(current = list->head; current != NULL; current = current->next) {
+        n++;
+    }
+    dynarray_reserve(da, n);
+
+    for(current = list->head; current != NULL; current = current->next) {
+        dynarray_insert(da, current->val);
+    }
+
+    return da;
+}
+
+/*
+ * This function allocates a new linked list holding the values of a dynamic
+ * array, in the same order.  Like list_from_array(), all of the nodes are
+ * allocated together with a single call to malloc().
+ *
+ * Params:
+ * da - the dynamic array whose values are to be copied.  May not be NULL.
+ *
+ * Return:
+ *   Returns a new list whose first node holds element 0 of the array, whose
+ *   second node holds element 1, and so forth.
+ */
+struct list* dynarray_to_list(struct dynarray* da)
+{
+    struct list* list = list_create();
+    node_fill(list, dynarray_size(da), dynarray_get_value, da);
+
+    return list;
+}
@@ -14,6 +14,12 @@
 struct node;
 struct list;
 
+/*
+ * Structure used to represent a dynamic array (see dynarray.h), for
+ * converting between lists and dynamic arrays.
+ */
+struct dynarray;
+
 /*
  * Linked list interface function prototypes.  Refer to list.c for
  * documentation about each of these functions.
@@ -24,7 +30,14 @@ void list_insert(struct list* list, void* val);
 void list_insert_end(struct list* list, void* val);
 void list_remove(struct list* list, void* val, int (*cmp)(void* a, void* b));
 void list_remove_end(struct list* list);
+int list_remove_all(struct list* list, void* val, int (*cmp)(void* a, void* b), void (*free_val)(void* val));
+int list_filter(struct list* list, int (*pred)(void* val, void* ctx), void* ctx, void (*free_val)(void* val));
 int list_position(struct list* list, void* val, int (*cmp)(void* a, void* b));
 void list_reverse(struct list* list);
+void list_sort(struct list* list, int (*cmp)(void* a, void* b));
+void list_merge(struct list* list, struct list* other, int (*cmp)(void* a, void* b));
+struct list* list_from_array(void** vals, int n);
+struct dynarray* list_to_dynarray(struct list* list);
+struct list* dynarray_to_list(struct dynarray* da);
 
 #endif
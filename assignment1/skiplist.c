@@ -0,0 +1,388 @@
+/*
+ * This file contains the implementation of a skip list.  A skip list keeps
+ * its values sorted in an ordinary singly-linked list (level 0) and adds
+ * "express lanes" on top of it: each node is also linked into a random number
+ * of higher levels, with roughly 1/4 of the nodes on each level also appearing
+ * on the level above.  Searches start on the highest level and drop down a
+ * level whenever the next node would overshoot, which gives expected
+ * O(log n) insert, find and remove without any rebalancing.
+ *
+ * Like the functions in list.h, the functions here are passed a *function
+ * pointer* called `cmp` to compare values.  Because a skip list is ordered,
+ * `cmp` must say how its two arguments are ordered: it should return a
+ * negative value if `a` comes before `b`, 0 if they are equal, and a positive
+ * value if `a` comes after `b` (just like the comparison functions passed to
+ * qsort()).  The same `cmp` must be used for every call on a given skip list.
+ *
+ * Name: Gabriel de Leon
+ * Email: deleong@oregonstate.edu
+ */
+
+#include <stdlib.h>
+#include <assert.h>
+
+#include "skiplist.h"
+
+/*
+ * This is the maximum number of levels a skip list can have.  With 1/4 of the
+ * nodes promoted to each next level, this is enough for about 4^16 values.
+ */
+#define SKIPLIST_MAX_LEVEL 16
+
+/*
+ * This structure represents a single node in a skip list.  `next` holds one
+ * forward link for each of the `height` levels the node belongs to, with
+ * next[0] being the link in the ordinary sorted linked list.
+ */
+struct skiplist_node {
+    void* val;
+    int height;
+    struct skiplist_node* next[];
+};
+
+/*
+ * This structure represents an entire skip list.  `head` is a sentinel node
+ * with SKIPLIST_MAX_LEVEL levels that doesn't hold a value, `level` is the
+ * number of levels currently in use, and `seed` is the state of the random
+ * number generator used to pick node heights.
+ */
+struct skiplist {
+    struct skiplist_node* head;
+    int level;
+    int size;
+    unsigned int seed;
+};
+
+/*
+ * This structure represents an iterator over the values of a skip list, in
+ * sorted order.
+ */
+struct skiplist_iterator {
+    struct skiplist_node* current;
+};
+
+/*
+ * This function allocates a new skip list node that belongs to `height`
+ * levels, with all of its forward links set to NULL.
+ */
+static struct skiplist_node* skiplist_node_create(void* val, int height)
+{
+    struct skiplist_node* node = malloc(sizeof(struct skiplist_node) + height * sizeof(struct skiplist_node*));
+    node->val = val;
+    node->height = height;
+
+    for(int i = 0; i < height; i++) {
+        node->next[i] = NULL;
+    }
+
+    return node;
+}
+
+/*
+ * This function picks the height of a new node.  Each node is on level 1,
+ * and it is promoted to each further level with probability 1/4.
+ */
+static int random_height(struct skiplist* sl)
+{
+    int height = 1;
+
+    //xorshift random number generator, which keeps each skip list independent
+    unsigned int x = sl->seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    sl->seed = x;
+
+    //every two bits that are both 0 promote the node one more level
+    while(height < SKIPLIST_MAX_LEVEL && (x & 3) == 0) {
+        height++;
+        x >>= 2;
+    }
+
+    return height;
+}
+
+/*
+ * This function finds, on every level, the last node whose value comes before
+ * `val`, and stores those nodes in `update`.  update[0]->next[0] is therefore
+ * the first node whose value is not less than `val` (or NULL).
+ */
+static void find_predecessors(struct skiplist* sl, void* val, int (*cmp)(void* a, void* b), struct skiplist_node** update)
+{
+    struct skiplist_node* current = sl->head;
+
+    //moves right as far as possible on each level, then drops down a level
+    for(int i = sl->level - 1; i >= 0; i--) {
+
+        while(current->next[i] != NULL && cmp(current->next[i]->val, val) < 0) {
+            current = current->next[i];
+        }
+
+        update[i] = current;
+    }
+}
+
+/*
+ * This function should allocate and initialize a new, empty skip list and
+ * return a pointer to it.
+ */
+struct skiplist* skiplist_create()
+{
+    struct skiplist* sl = malloc(sizeof(struct skiplist));
+
+    sl->head = skiplist_node_create(NULL, SKIPLIST_MAX_LEVEL);
+    sl->level = 1;
+    sl->size = 0;
+    sl->seed = 2463534242u;
+
+    return sl;
+}
+
+/*
+ * This function frees the memory associated with a skip list.  Like
+ * list_free(), it does not free the values stored in the skip list.  This is
+ * the responsibility of the caller.
+ *
+ * Params:
+ * sl - the skip list to be destroyed.  May not be NULL.
+ */
+void skiplist_free(struct skiplist* sl)
+{
+    assert(sl);
+
+    //every node is on level 0, so walking that level reaches all of them
+    struct skiplist_node* current = sl->head;
+    while(current != NULL) {
+        struct skiplist_node* temp = current;
+        current = current->next[0];
+        free(temp);
+    }
+
+    free(sl);
+
+    return;
+}
+
+/*
+ * This function returns the number of values stored in a skip list.
+ *
+ * Params:
+ * sl - the skip list whose values are to be counted.  May not be NULL.
+ */
+int skiplist_size(struct skiplist* sl)
+{
+    assert(sl);
+    return sl->size;
+}
+
+/*
+ * This function inserts a value into a skip list, keeping the values sorted.
+ * Since a skip list is a set, nothing is inserted if an equal value is
+ * already stored.  Runs in expected O(log n) time.
+ *
+ * Params:
+ * sl - the skip list into which to insert a value.  May not be NULL.
+ * val - the value to be inserted.
+ * cmp - pointer to a function that orders two void* values, as described at
+ *     the top of this file.
+ *
+ * Return:
+ *   Returns 1 if `val` was inserted, or 0 if an equal value was already in
+ *   the skip list.
+ */
+int skiplist_insert(struct skiplist* sl, void* val, int (*cmp)(void* a, void* b))
+{
+    assert(sl);
+
+    struct skiplist_node* update[SKIPLIST_MAX_LEVEL];
+    find_predecessors(sl, val, cmp, update);
+
+    //checks if the value is already in the set
+    struct skiplist_node* next = update[0]->next[0];
+    if(next != NULL && cmp(next->val, val) == 0) {
+        return 0;
+    }
+
+    int height = random_height(sl);
+
+    //levels that weren't in use yet start out at the head
+    while(sl->level < height) {
+        update[sl->level] = sl->head;
+        sl->level++;
+    }
+
+    //splices the new node in after its predecessor on each of its levels
+    struct skiplist_node* node = skiplist_node_create(val, height);
+    for(int i = 0; i < height; i++) {
+        node->next[i] = update[i]->next[i];
+        update[i]->next[i] = node;
+    }
+
+    sl->size++;
+
+    return 1;
+}
+
+/*
+ * This function looks for a value in a skip list.  Runs in expected O(log n)
+ * time.
+ *
+ * Params:
+ * sl - the skip list to be searched.  May not be NULL.
+ * val - the value to be located.
+ * cmp - pointer to a function that orders two void* values, as described at
+ *     the top of this file.
+ *
+ * Return:
+ *   Returns the value stored in the skip list that is equal to `val`, or NULL
+ *   if there is no such value.
+ */
+void* skiplist_find(struct skiplist* sl, void* val, int (*cmp)(void* a, void* b))
+{
+    void* lower = skiplist_lower_bound(sl, val, cmp);
+
+    //the lower bound is the value itself if the value is in the set
+    if(lower != NULL && cmp(lower, val) == 0) {
+        return lower;
+    }
+
+    return NULL;
+}
+
+/*
+ * This function removes a value from a skip list.  Like list_remove(), it
+ * frees the node that held the value but not the value itself.  Runs in
+ * expected O(log n) time.
+ *
+ * Params:
+ * sl - the skip list from which to remove a value.  May not be NULL.
+ * val - the value to be removed.
+ * cmp - pointer to a function that orders two void* values, as described at
+ *     the top of this file.
+ *
+ * Return:
+ *   Returns 1 if a value was removed, or 0 if `val` wasn't in the skip list.
+ */
+int skiplist_remove(struct skiplist* sl, void* val, int (*cmp)(void* a, void* b))
+{
+    assert(sl);
+
+    struct skiplist_node* update[SKIPLIST_MAX_LEVEL];
+    find_predecessors(sl, val, cmp, update);
+
+    //checks that the value is actually in the set
+    struct skiplist_node* node = update[0]->next[0];
+    if(node == NULL || cmp(node->val, val) != 0) {
+        return 0;
+    }
+
+    //unlinks the node from each of its levels
+    for(int i = 0; i < node->height; i++) {
+        update[i]->next[i] = node->next[i];
+    }
+    free(node);
+
+    //drops levels that no longer have any nodes on them
+    while(sl->level > 1 && sl->head->next[sl->level - 1] == NULL) {
+        sl->level--;
+    }
+
+    sl->size--;
+
+    return 1;
+}
+
+/*
+ * This function finds the smallest value in a skip list that is not less
+ * than a given value.  Runs in expected O(log n) time.
+ *
+ * Params:
+ * sl - the skip list to be searched.  May not be NULL.
+ * val - the value to compare against.
+ * cmp - pointer to a function that orders two void* values, as described at
+ *     the top of this file.
+ *
+ * Return:
+ *   Returns the first value in sorted order that is greater than or equal to
+ *   `val`, or NULL if every value in the skip list is less than `val`.
+ */
+void* skiplist_lower_bound(struct skiplist* sl, void* val, int (*cmp)(void* a, void* b))
+{
+    assert(sl);
+
+    struct skiplist_node* update[SKIPLIST_MAX_LEVEL];
+    find_predecessors(sl, val, cmp, update);
+
+    struct skiplist_node* node = update[0]->next[0];
+    if(node == NULL) {
+        return NULL;
+    }
+
+    return node->val;
+}
+
+/*
+ * This function allocates and initializes an iterator over the values of a
+ * skip list.  The values are returned in sorted order.  The skip list should
+ * not be modified while the iterator is in use.
+ *
+ * Params:
+ * sl - the skip list over which to create an iterator.  May not be NULL.
+ */
+struct skiplist_iterator* skiplist_iterator_create(struct skiplist* sl)
+{
+    assert(sl);
+
+    struct skiplist_iterator* iter = malloc(sizeof(struct skiplist_iterator));
+    iter->current = sl->head->next[0];
+
+    return iter;
+}
+
+/*
+ * This function frees the memory associated with a skip list iterator.
+ *
+ * Params:
+ * iter - the iterator to be destroyed.  May not be NULL.
+ */
+void skiplist_iterator_free(struct skiplist_iterator* iter)
+{
+    assert(iter);
+    free(iter);
+}
+
+/*
+ * This function indicates whether there are more values left to be returned
+ * by a skip list iterator.
+ *
+ * Params:
+ * iter - the iterator to be checked.  May not be NULL.
+ *
+ * Return:
+ *   Returns 1 if `iter` has more values left, or 0 otherwise.
+ */
+int skiplist_iterator_has_next(struct skiplist_iterator* iter)
+{
+    assert(iter);
+    return iter->current != NULL;
+}
+
+/*
+ * This function returns the next value from a skip list iterator.  It may
+ * only be called if skiplist_iterator_has_next() returns 1.
+ *
+ * Params:
+ * iter - the iterator from which to get the next value.  May not be NULL.
+ *
+ * Return:
+ *   Returns the next value in sorted order.
+ */
+void* skiplist_iterator_next(struct skiplist_iterator* iter)
+{
+    assert(iter && iter->current);
+
+    void* val = iter->current->val;
+    iter->current = iter->current->next[0];
+
+    return val;
+}
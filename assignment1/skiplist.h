@@ -0,0 +1,42 @@
+/*
+ * This file contains the definition of the interface for a skip list, which
+ * is an ordered set built out of several levels of linked lists.  You can find
+ * descriptions of the skip list functions, including their parameters and
+ * their return values, in skiplist.c.
+ */
+
+#ifndef __SKIPLIST_H
+#define __SKIPLIST_H
+
+/*
+ * Structure used to represent a skip list.
+ */
+struct skiplist;
+
+/*
+ * Skip list interface function prototypes.  Refer to skiplist.c for
+ * documentation about each of these functions.
+ */
+struct skiplist* skiplist_create();
+void skiplist_free(struct skiplist* sl);
+int skiplist_size(struct skiplist* sl);
+int skiplist_insert(struct skiplist* sl, void* val, int (*cmp)(void* a, void* b));
+void* skiplist_find(struct skiplist* sl, void* val, int (*cmp)(void* a, void* b));
+int skiplist_remove(struct skiplist* sl, void* val, int (*cmp)(void* a, void* b));
+void* skiplist_lower_bound(struct skiplist* sl, void* val, int (*cmp)(void* a, void* b));
+
+/*
+ * Structure used to represent a skip list iterator.
+ */
+struct skiplist_iterator;
+
+/*
+ * Skip list iterator interface prototypes.  Refer to skiplist.c for
+ * documentation about each of these functions.
+ */
+struct skiplist_iterator* skiplist_iterator_create(struct skiplist* sl);
+void skiplist_iterator_free(struct skiplist_iterator* iter);
+int skiplist_iterator_has_next(struct skiplist_iterator* iter);
+void* skiplist_iterator_next(struct skiplist_iterator* iter);
+
+#endif
@@ -0,0 +1,126 @@
+/*
+ * This file contains executable code for testing the concurrent linked list
+ * implementation.  Several threads insert, remove and look up values in the
+ * same list at the same time.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#include "clist.h"
+#include "epoch.h"
+
+#define NUM_THREADS 8
+#define VALUES_PER_THREAD 2000
+
+/*
+ * These are the values stored in the list.  Thread t owns the values
+ * t, t + NUM_THREADS, t + 2 * NUM_THREADS, and so on.
+ */
+int values[NUM_THREADS * VALUES_PER_THREAD];
+
+/*
+ * This structure holds the arguments and results of a single worker thread.
+ */
+struct worker {
+    struct clist* list;
+    int id;
+    int errors;
+};
+
+/*
+ * This function compares two integers for ordering.
+ */
+int compare_ints(void* a, void* b)
+{
+    return *(int*)a - *(int*)b;
+}
+
+/*
+ * Each worker inserts all of its values, checks that it can see them, and
+ * then removes every other one.
+ */
+void* worker(void* arg)
+{
+    struct worker* w = arg;
+    int i;
+
+    for (i = w->id; i < NUM_THREADS * VALUES_PER_THREAD; i += NUM_THREADS) {
+        clist_insert(w->list, &values[i], &compare_ints);
+    }
+
+    for (i = w->id; i < NUM_THREADS * VALUES_PER_THREAD; i += NUM_THREADS) {
+        if (!clist_contains(w->list, &values[i], &compare_ints))
+            w->errors++;
+    }
+
+    for (i = w->id; i < NUM_THREADS * VALUES_PER_THREAD; i += 2 * NUM_THREADS) {
+        if (!clist_remove(w->list, &values[i], &compare_ints))
+            w->errors++;
+        if (clist_remove(w->list, &values[i], &compare_ints))
+            w->errors++;
+    }
+
+    return NULL;
+}
+
+int main(int argc, char** argv)
+{
+    pthread_t threads[NUM_THREADS];
+    struct worker workers[NUM_THREADS];
+    struct clist* list;
+    int i, present, missing, errors;
+
+    for (i = 0; i < NUM_THREADS * VALUES_PER_THREAD; i++) {
+        values[i] = i;
+    }
+
+    list = clist_create();
+    printf("Checking that list is not NULL... ");
+    if (list == NULL)
+        printf("FAILED\n");
+    else
+        printf("OK\n");
+
+    printf("\nRunning %d threads with %d values each... ", NUM_THREADS,
+        VALUES_PER_THREAD);
+    fflush(stdout);
+    for (i = 0; i < NUM_THREADS; i++) {
+        workers[i].list = list;
+        workers[i].id = i;
+        workers[i].errors = 0;
+        pthread_create(&threads[i], NULL, worker, &workers[i]);
+    }
+    errors = 0;
+    for (i = 0; i < NUM_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+        errors += workers[i].errors;
+    }
+    printf("OK\n");
+    printf("Errors seen by the threads (should be 0)... %d\n", errors);
+
+    /*
+     * Every other value of each thread should have been removed.
+     */
+    present = 0;
+    missing = 0;
+    for (i = 0; i < NUM_THREADS * VALUES_PER_THREAD; i++) {
+        int expected = (i / NUM_THREADS) % 2 == 1;
+        if (clist_contains(list, &values[i], &compare_ints) != expected)
+            missing++;
+        else if (expected)
+            present++;
+    }
+    printf("Values left in the list (should be %d)... %d\n",
+        NUM_THREADS * VALUES_PER_THREAD / 2, present);
+    printf("Values with the wrong membership (should be 0)... %d\n", missing);
+
+    printf("\nFreeing list... ");
+    fflush(stdout);
+    clist_free(list);
+    epoch_flush();
+    printf("OK (check valgrind output to ensure no memory leaks)\n");
+
+    return 0;
+}
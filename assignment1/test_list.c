@@ -7,14 +7,32 @@
 #include <stdlib.h>
 
 #include "list.h"
+#include "dynarray.h"
 #include "test_data.h"
 
+/*
+ * This is the GPA cutoff used to test list_filter().
+ */
+float min_gpa = 3.0;
+
+/*
+ * This function is used to test list_filter().  It matches students whose GPA
+ * is below the cutoff passed in `ctx`.
+ */
+int gpa_below(void* a, void* ctx)
+{
+    struct student* s = a;
+    return s->gpa < *(float*)ctx;
+}
+
 /*
  * Function to run tests on linked list implementation.
  */
 void test_list(struct student** students, int n) 
 {
     struct list* list;
+    struct list* other;
+    struct dynarray* da;
     struct student* s;
     int i, p;
 
@@ -145,6 +163,141 @@ void test_list(struct student** students, int n)
     list_free(list);
 
     printf("OK (check valgrind output to ensure no memory leaks)\n");
+
+
+    /*
+     * Add students in a scrambled order and make sure sorting puts them back
+     * in order of their ids.
+     */
+    list = list_create();
+    printf("\nAdding students in scrambled order...\n");
+    for (i = 0; i < n; i++) {
+        list_insert(list, students[(i * 3) % n]);
+    }
+    printf("Sorting list... ");
+    fflush(stdout);
+    list_sort(list, &compare_students);
+    printf("OK (check for correct positions below)\n");
+    for (i = 0; i < n; i++) {
+        printf("Position of students[%d] (should be %d)... ", i, i);
+        fflush(stdout);
+        p = list_position(list, students[i], &compare_students);
+        printf("%d\n", p);
+    }
+
+    /*
+     * Split the students into two sorted lists and merge them back together.
+     */
+    list_free(list);
+    list = list_create();
+    other = list_create();
+    for (i = n - 1; i >= 0; i--) {
+        if (i % 2 == 0)
+            list_insert(list, students[i]);
+        else
+            list_insert(other, students[i]);
+    }
+    printf("\nMerging two sorted lists... ");
+    fflush(stdout);
+    list_merge(list, other, &compare_students);
+    printf("OK (check for correct positions below)\n");
+    for (i = 0; i < n; i++) {
+        printf("Position of students[%d] (should be %d)... ", i, i);
+        fflush(stdout);
+        p = list_position(list, students[i], &compare_students);
+        printf("%d\n", p);
+    }
+    printf("Position of students[1] in emptied list (should be -1)... ");
+    fflush(stdout);
+    p = list_position(other, students[1], &compare_students);
+    printf("%d\n", p);
+
+    list_free(other);
+    list_free(list);
+
+
+    /*
+     * Build a list straight from the array of students and convert it to a
+     * dynamic array and back.
+     */
+    printf("\nBuilding list from array... ");
+    fflush(stdout);
+    list = list_from_array((void**)students, n);
+    printf("OK (check for correct positions below)\n");
+    for (i = 0; i < n; i++) {
+        printf("Position of students[%d] (should be %d)... ", i, i);
+        fflush(stdout);
+        p = list_position(list, students[i], &compare_students);
+        printf("%d\n", p);
+    }
+
+    printf("\nConverting list to dynamic array... ");
+    fflush(stdout);
+    da = list_to_dynarray(list);
+    printf("OK\n");
+    printf("Size of dynamic array (should be %d)... %d\n", n,
+        dynarray_size(da));
+    for (i = 0; i < n; i++) {
+        s = dynarray_get(da, i);
+        printf("Element %d of dynamic array (should be %s)... %s\n", i,
+            students[i]->name, s->name);
+    }
+
+    printf("\nConverting dynamic array back to list... ");
+    fflush(stdout);
+    other = dynarray_to_list(da);
+    printf("OK (check for correct positions below)\n");
+    for (i = 0; i < n; i++) {
+        printf("Position of students[%d] (should be %d)... ", i, i);
+        fflush(stdout);
+        p = list_position(other, students[i], &compare_students);
+        printf("%d\n", p);
+    }
+
+    /*
+     * Nodes of bulk-built lists can still be removed and inserted.
+     */
+    printf("\nRemoving students[0] and adding it back at the end... ");
+    fflush(stdout);
+    list_remove(other, students[0], &compare_students);
+    list_insert_end(other, students[0]);
+    printf("OK\n");
+    printf("Position of students[0] (should be %d)... %d\n", n - 1,
+        list_position(other, students[0], &compare_students));
+
+    dynarray_free(da);
+    list_free(other);
+    list_free(list);
+
+
+    /*
+     * Add every student twice and remove all copies of some of them in one
+     * pass, then filter out the students with low GPAs.
+     */
+    list = list_create();
+    for (i = n - 1; i >= 0; i--) {
+        list_insert(list, students[i]);
+        list_insert(list, students[i]);
+    }
+    printf("\nRemoving all copies of students[3] (should remove 2)... ");
+    fflush(stdout);
+    p = list_remove_all(list, students[3], &compare_students, NULL);
+    printf("%d\n", p);
+    printf("Position of students[3] (should be -1)... %d\n",
+        list_position(list, students[3], &compare_students));
+    printf("Position of students[4] (should be 6)... %d\n",
+        list_position(list, students[4], &compare_students));
+
+    printf("\nFiltering out students with GPA below 3.0 (should remove 2)... ");
+    fflush(stdout);
+    p = list_filter(list, &gpa_below, &min_gpa, NULL);
+    printf("%d\n", p);
+    printf("Position of students[5] (should be -1)... %d\n",
+        list_position(list, students[5], &compare_students));
+    printf("Position of students[6] (should be 8)... %d\n",
+        list_position(list, students[6], &compare_students));
+
+    list_free(list);
 }
 
 int main(int argc, char** argv) 
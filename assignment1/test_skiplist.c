@@ -0,0 +1,141 @@
+/*
+ * This file contains executable code for testing the skip list
+ * implementation.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "skiplist.h"
+#include "test_data.h"
+
+/*
+ * Function to run tests on skip list implementation.
+ */
+void test_skiplist(struct student** students, int n)
+{
+    struct skiplist* sl;
+    struct skiplist_iterator* iter;
+    struct student* s;
+    int i, r;
+
+    sl = skiplist_create();
+    printf("Checking that skip list is not NULL... ");
+    fflush(stdout);
+    if (sl == NULL)
+        printf("FAILED\n");
+    else
+        printf("OK\n");
+
+    /*
+     * Add students in a scrambled order; the skip list should keep them
+     * sorted by id.
+     */
+    printf("\n");
+    for (i = 0; i < n; i++) {
+        printf("Inserting students[%d] (should be 1)... ", (i * 3) % n);
+        fflush(stdout);
+        r = skiplist_insert(sl, students[(i * 3) % n], &compare_students);
+        printf("%d\n", r);
+    }
+    printf("Inserting students[0] again (should be 0)... ");
+    r = skiplist_insert(sl, students[0], &compare_students);
+    printf("%d\n", r);
+    printf("Size of skip list (should be %d)... %d\n", n, skiplist_size(sl));
+
+    /*
+     * Check that every student can be found.
+     */
+    printf("\n");
+    for (i = 0; i < n; i++) {
+        printf("Finding students[%d]... ", i);
+        fflush(stdout);
+        s = skiplist_find(sl, students[i], &compare_students);
+        printf("%s\n", s == students[i] ? "OK" : "FAILED");
+    }
+
+    /*
+     * Check that iteration returns the students in order.
+     */
+    printf("\nIterating over skip list...\n");
+    iter = skiplist_iterator_create(sl);
+    i = 0;
+    while (skiplist_iterator_has_next(iter)) {
+        s = skiplist_iterator_next(iter);
+        printf("  Student %d: %s (should be %s)\n", i, s->name,
+            students[i]->name);
+        i++;
+    }
+    skiplist_iterator_free(iter);
+
+    /*
+     * Check lower bounds for a student id that's between two others.
+     */
+    s = malloc(sizeof(struct student));
+    s->name = "Kylo Ren";
+    s->id = students[2]->id + 1;
+    s->gpa = 0.75;
+    printf("\nLower bound of id %d (should be %s)... ", s->id,
+        students[3]->name);
+    fflush(stdout);
+    printf("%s\n", ((struct student*)skiplist_lower_bound(sl, s,
+        &compare_students))->name);
+    printf("Finding non-existent student (should be NULL)... %s\n",
+        skiplist_find(sl, s, &compare_students) ? "non-NULL" : "NULL");
+    s->id = students[n - 1]->id + 1;
+    printf("Lower bound past the last student (should be NULL)... %s\n",
+        skiplist_lower_bound(sl, s, &compare_students) ? "non-NULL" : "NULL");
+    free(s);
+
+    /*
+     * Test removing students.
+     */
+    for (i = n - 1; i > 0; i /= 2) {
+        printf("\nRemoving students[%d] (should be 1)... ", i);
+        fflush(stdout);
+        r = skiplist_remove(sl, students[i], &compare_students);
+        printf("%d\n", r);
+        printf("Removing students[%d] again (should be 0)... ", i);
+        r = skiplist_remove(sl, students[i], &compare_students);
+        printf("%d\n", r);
+        printf("Finding students[%d] (should be NULL)... %s\n", i,
+            skiplist_find(sl, students[i], &compare_students) ? "non-NULL" :
+            "NULL");
+    }
+    printf("\nSize of skip list (should be %d)... %d\n", n - 3,
+        skiplist_size(sl));
+
+    printf("\nFreeing skip list... ");
+    fflush(stdout);
+    skiplist_free(sl);
+    printf("OK (check valgrind output to ensure no memory leaks)\n");
+}
+
+int main(int argc, char** argv)
+{
+    struct student** students;
+    int i;
+
+    /*
+     * Create and fill an array of student structs.
+     */
+    students = malloc(NUM_TESTING_STUDENTS * sizeof(struct student*));
+    for (i = 0; i < NUM_TESTING_STUDENTS; i++) {
+        students[i] = malloc(sizeof(struct student));
+        students[i]->name = TESTING_NAMES[i];
+        students[i]->id = TESTING_IDS[i];
+        students[i]->gpa = TESTING_GPAS[i];
+    }
+
+    test_skiplist(students, NUM_TESTING_STUDENTS);
+
+    /*
+     * Free the array of student structs.
+     */
+    for (i = 0; i < NUM_TESTING_STUDENTS; i++) {
+        free(students[i]);
+    }
+    free(students);
+
+    return 0;
+}
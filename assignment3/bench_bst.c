@@ -0,0 +1,142 @@
+/*
+ * This file contains executable code for benchmarking the BST with keys
+ * inserted in sorted, reverse-sorted and random order.  For each order it
+ * reports the time taken to insert and then look up every key (one at a time
+ * with bst_get(), one at a time through a cursor, all at once with
+ * bst_get_many(), and one at a time in a frozen copy of the tree), along with
+ * the height of the resulting tree.  The same keys are then inserted into and
+ * looked up in a B+ tree for comparison.
+ *
+ * Usage: ./bench_bst [number of keys]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "bst.h"
+#include "bst_frozen.h"
+#include "btree.h"
+
+#define DEFAULT_NUM_KEYS 1000000
+
+/*
+ * This function returns the number of seconds since `start`.
+ */
+double seconds_since(clock_t start) {
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+/*
+ * This function builds a BST by inserting `keys` in the order given, then
+ * looks each key up again, and prints how long both steps took.
+ */
+void bench_order(const char* name, int* keys, int n) {
+  struct bst* bst = bst_create();
+  int missing = 0;
+
+  clock_t start = clock();
+  for (int i = 0; i < n; i++) {
+    bst_insert(bst, keys[i], &keys[i]);
+  }
+  double insert_time = seconds_since(start);
+
+  start = clock();
+  for (int i = 0; i < n; i++) {
+    if (bst_get(bst, keys[i]) == NULL) {
+      missing++;
+    }
+  }
+  double get_time = seconds_since(start);
+
+  struct bst_cursor* cursor = bst_cursor_create(bst);
+  start = clock();
+  for (int i = 0; i < n; i++) {
+    if (bst_cursor_get(cursor, keys[i]) == NULL) {
+      missing++;
+    }
+  }
+  double cursor_time = seconds_since(start);
+  bst_cursor_free(cursor);
+
+  void** values = malloc(n * sizeof(void*));
+  start = clock();
+  bst_get_many(bst, keys, n, values);
+  double get_many_time = seconds_since(start);
+  free(values);
+
+  struct bst_frozen* frozen = bst_freeze(bst);
+  start = clock();
+  for (int i = 0; i < n; i++) {
+    if (bst_frozen_get(frozen, keys[i]) == NULL) {
+      missing++;
+    }
+  }
+  double frozen_time = seconds_since(start);
+  bst_frozen_free(frozen);
+
+  printf("  %-14s insert: %7.3fs  get: %7.3fs  cursor get: %7.3fs  "
+    "get_many: %7.3fs  frozen get: %7.3fs  height: %3d  missing: %d\n", name,
+    insert_time, get_time, cursor_time, get_many_time, frozen_time,
+    bst_height(bst), missing);
+
+  bst_free(bst);
+
+  struct btree* btree = btree_create();
+  missing = 0;
+
+  start = clock();
+  for (int i = 0; i < n; i++) {
+    btree_insert(btree, keys[i], &keys[i]);
+  }
+  insert_time = seconds_since(start);
+
+  start = clock();
+  for (int i = 0; i < n; i++) {
+    if (btree_get(btree, keys[i]) == NULL) {
+      missing++;
+    }
+  }
+  get_time = seconds_since(start);
+
+  printf("  %-14s insert: %7.3fs  get: %7.3fs  (B+ tree)  missing: %d\n",
+    name, insert_time, get_time, missing);
+
+  btree_free(btree);
+}
+
+int main(int argc, char** argv) {
+  int n = DEFAULT_NUM_KEYS;
+  if (argc > 1) {
+    n = atoi(argv[1]);
+  }
+
+  int* keys = malloc(n * sizeof(int));
+  printf("== Benchmarking BST with %d keys...\n", n);
+
+  for (int i = 0; i < n; i++) {
+    keys[i] = i;
+  }
+  bench_order("sorted", keys, n);
+
+  for (int i = 0; i < n; i++) {
+    keys[i] = n - i;
+  }
+  bench_order("reverse", keys, n);
+
+  /*
+   * Shuffle the keys with a Fisher-Yates shuffle for the random order.
+   */
+  srand(0);
+  for (int i = n - 1; i > 0; i--) {
+    int j = rand() % (i + 1);
+    int temp = keys[i];
+    keys[i] = keys[j];
+    keys[j] = temp;
+  }
+  bench_order("random", keys, n);
+
+  free(keys);
+
+  return 0;
+}
@@ -0,0 +1,151 @@
+/*
+ * This file contains executable code for benchmarking the splay tree against
+ * the BST.  Both trees hold the same keys, and both are sent the same lookups,
+ * drawn either uniformly or from a Zipf distribution in which the k-th most
+ * popular key is looked up with probability proportional to 1 / k^s.  The
+ * larger the exponent s, the more the lookups pile up on the popular keys.
+ *
+ * Usage: ./bench_splay [number of keys] [number of lookups] [zipf exponent]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <math.h>
+
+#include "bst.h"
+#include "splay.h"
+
+#define DEFAULT_NUM_KEYS 1000000
+#define DEFAULT_NUM_LOOKUPS 2000000
+#define DEFAULT_ZIPF_EXPONENT 1.0
+
+/*
+ * This function returns the number of seconds since `start`.
+ */
+double seconds_since(clock_t start) {
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+/*
+ * This function returns a random number in [0, 1).
+ */
+double random_unit() {
+  return ((double)rand() * ((double)RAND_MAX + 1) + rand())
+    / (((double)RAND_MAX + 1) * ((double)RAND_MAX + 1));
+}
+
+/*
+ * This function fills `lookups` with keys drawn from a Zipf distribution over
+ * `keys` with exponent `s`, where keys[0] is the most popular.  It inverts the
+ * cumulative distribution with a binary search.
+ */
+void fill_zipf(int* lookups, int num_lookups, int* keys, int n, double s) {
+  double* cdf = malloc(n * sizeof(double));
+  double total = 0;
+  for (int k = 0; k < n; k++) {
+    total += 1.0 / pow(k + 1, s);
+    cdf[k] = total;
+  }
+
+  for (int i = 0; i < num_lookups; i++) {
+    double target = random_unit() * total;
+    int lo = 0, hi = n - 1;
+    while (lo < hi) {
+      int mid = lo + (hi - lo) / 2;
+      if (cdf[mid] < target) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    lookups[i] = keys[lo];
+  }
+
+  free(cdf);
+}
+
+/*
+ * This function looks up every key in `lookups` in both trees and prints how
+ * long each tree took.
+ */
+void bench_lookups(const char* name, struct bst* bst, struct splay* splay,
+    int* lookups, int num_lookups) {
+  int missing = 0;
+
+  clock_t start = clock();
+  for (int i = 0; i < num_lookups; i++) {
+    if (bst_get(bst, lookups[i]) == NULL) {
+      missing++;
+    }
+  }
+  double bst_time = seconds_since(start);
+
+  start = clock();
+  for (int i = 0; i < num_lookups; i++) {
+    if (splay_get(splay, lookups[i]) == NULL) {
+      missing++;
+    }
+  }
+  double splay_time = seconds_since(start);
+
+  printf("  %-8s bst: %7.3fs  splay: %7.3fs  missing: %d\n", name, bst_time,
+    splay_time, missing);
+}
+
+int main(int argc, char** argv) {
+  int n = DEFAULT_NUM_KEYS;
+  int num_lookups = DEFAULT_NUM_LOOKUPS;
+  double s = DEFAULT_ZIPF_EXPONENT;
+  if (argc > 1) {
+    n = atoi(argv[1]);
+  }
+  if (argc > 2) {
+    num_lookups = atoi(argv[2]);
+  }
+  if (argc > 3) {
+    s = atof(argv[3]);
+  }
+
+  /*
+   * Shuffle the keys with a Fisher-Yates shuffle, so the inserts are in
+   * random order and the popular keys are spread over the key space.
+   */
+  int* keys = malloc(n * sizeof(int));
+  for (int i = 0; i < n; i++) {
+    keys[i] = i;
+  }
+  srand(0);
+  for (int i = n - 1; i > 0; i--) {
+    int j = rand() % (i + 1);
+    int temp = keys[i];
+    keys[i] = keys[j];
+    keys[j] = temp;
+  }
+
+  struct bst* bst = bst_create();
+  struct splay* splay = splay_create();
+  for (int i = 0; i < n; i++) {
+    bst_insert(bst, keys[i], &keys[i]);
+    splay_insert(splay, keys[i], &keys[i]);
+  }
+
+  printf("== Benchmarking %d lookups in trees of %d keys...\n", num_lookups,
+    n);
+  int* lookups = malloc(num_lookups * sizeof(int));
+
+  for (int i = 0; i < num_lookups; i++) {
+    lookups[i] = keys[(int)(random_unit() * n)];
+  }
+  bench_lookups("uniform", bst, splay, lookups, num_lookups);
+
+  fill_zipf(lookups, num_lookups, keys, n, s);
+  bench_lookups("zipf", bst, splay, lookups, num_lookups);
+
+  free(lookups);
+  bst_free(bst);
+  splay_free(splay);
+  free(keys);
+
+  return 0;
+}
@@ -10,9 +10,38 @@
  */
 
 #include <stdlib.h>
+#include <limits.h>
+#include <pthread.h>
 
 #include "bst.h"
-#include "stack.h"
+
+/*
+ * This is the largest height an AVL tree with fewer than 2^31 nodes can have
+ * (about 1.44 * log2(n)), with a little room to spare.  Since the tree is
+ * always balanced, a path from the root never needs more entries than this.
+ */
+#define BST_MAX_HEIGHT 48
+
+/*
+ * This is the number of lookups bst_get_many() keeps in flight at once.
+ */
+#define GET_MANY_BATCH 8
+
+/*
+ * This is the smallest subtree bst_path_sum_parallel() hands to another
+ * thread.  Smaller subtrees are searched faster than a thread can start.
+ */
+#define PATH_SUM_CUTOFF 16384
+
+/*
+ * This asks the CPU to start loading a node into cache before it's needed.
+ * It is only a hint, so it's left out for compilers without the builtin.
+ */
+#if defined(__GNUC__)
+#define PREFETCH(ptr) __builtin_prefetch(ptr)
+#else
+#define PREFETCH(ptr)
+#endif
 
 /*
  * This structure represents a single node in a BST.  In addition to containing
@@ -22,426 +51,755 @@
  * node.  Nodes in the BST should be ordered based on this `key` field.  The
  * `value` field stores data associated with the key.
  *
- * You should not modify this structure.
+ * The tree is kept balanced as an AVL tree, so each node also stores the
+ * `height` of the subtree rooted at it (1 for a leaf).  Each node also stores
+ * the number of nodes in its subtree (`size`) and the sum of their keys
+ * (`sum`), which lets rank, select and range queries skip whole subtrees.
+ *
+ * `count` is the number of values stored at the node.  It is always 1 except
+ * in a multimap, where one node holds every value inserted with its key.  Once
+ * a node holds more than one value, `value` points to a `struct bst_bucket`
+ * holding all of them.  `size` and `sum` count each value separately, so a
+ * key stored k times counts k times.
  */
 struct bst_node {
   int key;
+  int height;
+  int size;
+  int count;
+  long long sum;
   void* value;
   struct bst_node* left;
   struct bst_node* right;
 };
 
 
+/*
+ * This structure holds the values of a multimap node with more than one
+ * value, in the order they were inserted.  It has room for `capacity` values.
+ */
+struct bst_bucket {
+  int capacity;
+  void* values[];
+};
+
+/*
+ * This is the number of values a bucket has room for when it's first made.
+ */
+#define BUCKET_MIN_CAPACITY 4
+
 /*
  * This structure represents an entire BST.  It specifically contains a
- * reference to the root node of the tree.
- *
- * You should not modify this structure.
+ * reference to the root node of the tree, along with the number of values in
+ * the tree, which is kept up to date by bst_insert() and bst_remove() so that
+ * bst_size() doesn't need to walk the tree.  `multimap` is 1 if equal keys
+ * share one node instead of each getting their own.  `version` goes up every
+ * time the tree is changed, so cursors can tell when their saved path is out
+ * of date.
  */
 struct bst {
   struct bst_node* root;
+  int size;
+  int multimap;
+  unsigned long version;
 };
 
+/*****************************************************************************
+ **
+ ** AVL balancing helpers
+ **
+ *****************************************************************************/
+
 /*
- * This function should allocate and initialize a new, empty, BST and return
- * a pointer to it.
+ * This function returns the height of a subtree, where an empty subtree has
+ * height 0 and a single leaf has height 1.
  */
-struct bst* bst_create() {
-  
-  struct bst* bst = malloc(sizeof(struct bst));
-  bst->root = NULL;
-
-  return bst;
+static int node_height(struct bst_node* node) {
+  return node == NULL ? 0 : node->height;
 }
 
 /*
- * This function frees up all the memory allocated to the nodes in the bst
- *
- * Params:
- *   node - node we want to free, should start with root and then iterate throughout the list
+ * These functions return the number of nodes in a subtree and the sum of the
+ * keys in it, where an empty subtree has size and sum 0.
  */
-void node_free(struct bst_node* node) {
+static int node_size(struct bst_node* node) {
+  return node == NULL ? 0 : node->size;
+}
 
-  //iterates through left side
-  if(node->left != NULL) {
-    node_free(node->left);
-  }
+static long long node_sum(struct bst_node* node) {
+  return node == NULL ? 0 : node->sum;
+}
 
-  //iterates through right side
-  if(node->right != NULL) {
-    node_free(node->right);
-  }
+/*
+ * This function recomputes the stored height, size and key sum of a node from
+ * its children.
+ */
+static void node_update(struct bst_node* node) {
+  int left = node_height(node->left);
+  int right = node_height(node->right);
+  node->height = (left > right ? left : right) + 1;
+  node->size = node_size(node->left) + node_size(node->right) + node->count;
+  node->sum = node_sum(node->left) + node_sum(node->right) + (long long)node->key * node->count;
+}
 
-  //frees node itself
-  free(node);
-  node = NULL;
+/*
+ * This function returns the array of values stored at a node, which has
+ * node->count entries.
+ */
+static void** node_values(struct bst_node* node) {
+  if(node->count > 1) {
+    return ((struct bst_bucket*)node->value)->values;
+  }
+  return &node->value;
 }
 
 /*
- * This function should free the memory associated with a BST.  While this
- * function should up all memory used in the BST itself, it should not free
- * any memory allocated to the pointer values stored in the BST.  This is the
- * responsibility of the caller.
- *
- * Params:
- *   bst - the BST to be destroyed.  May not be NULL.
+ * This function adds a value to the end of a node's values, moving them into
+ * a bucket (or a bigger one) if needed.  The caller must update the node.
  */
-void bst_free(struct bst* bst) {
+static void node_add_value(struct bst_node* node, void* value) {
 
-  //frees all memory allocated to the nodes in the bst
-  node_free(bst->root);
+  struct bst_bucket* bucket = node->value;
 
-  //frees the bst itself
-  free(bst);
-  bst = NULL;
+  //a node with one value keeps it directly, so it needs a new bucket
+  if(node->count == 1) {
+    bucket = malloc(sizeof(struct bst_bucket) + BUCKET_MIN_CAPACITY * sizeof(void*));
+    bucket->capacity = BUCKET_MIN_CAPACITY;
+    bucket->values[0] = node->value;
+  }
+
+  else if(node->count == bucket->capacity) {
+    bucket = realloc(bucket, sizeof(struct bst_bucket) + 2 * bucket->capacity * sizeof(void*));
+    bucket->capacity *= 2;
+  }
+
+  bucket->values[node->count++] = value;
+  node->value = bucket;
 }
 
 /*
- * This function should recursively call this function whenever there is a node to the left and/or right of 
- * the current node and then return the size of the whole tree
- * 
- * Params:
- *   bst_node - the node that we are currently looping through to see if the right and left node are NULL or defined
+ * This function removes the last value added to a node that has more than
+ * one, going back to storing the value directly when only one is left.  The
+ * caller must update the node.
  */
-int bst_count(struct bst_node* root) {
+static void node_remove_value(struct bst_node* node) {
 
-  //counter for size of bst
-  int count = 1;
+  struct bst_bucket* bucket = node->value;
 
-  //checks if there is a node to the left and adds to count if so and recursively calls the function with the left node
-  if(root->left != NULL) {
-    count += bst_count(root->left);
+  if(--node->count == 1) {
+    node->value = bucket->values[0];
+    free(bucket);
   }
+}
 
-  //checks if there is a node to the right and adds to count if so and recursively calls the function with the right node
-  if(root->right != NULL) {
-    count += bst_count(root->right);
-  }
+/*
+ * These functions rotate the subtree rooted at `node` to the right or to the
+ * left and return the new root of the subtree.  In-order key order is kept.
+ */
+static struct bst_node* rotate_right(struct bst_node* node) {
+  struct bst_node* pivot = node->left;
+  node->left = pivot->right;
+  pivot->right = node;
+  node_update(node);
+  node_update(pivot);
+  return pivot;
+}
 
-  return count;
+static struct bst_node* rotate_left(struct bst_node* node) {
+  struct bst_node* pivot = node->right;
+  node->right = pivot->left;
+  pivot->left = node;
+  node_update(node);
+  node_update(pivot);
+  return pivot;
 }
 
 /*
- * This function should return the total number of elements stored in a given
- * BST.
- *
- * Params:
- *   bst - the BST whose elements are to be counted.  May not be NULL.
+ * This function restores the AVL property (the heights of a node's two
+ * subtrees differ by at most one) at a node whose subtrees are already
+ * balanced, and returns the new root of the subtree.
  */
-int bst_size(struct bst* bst) {
+static struct bst_node* rebalance(struct bst_node* node) {
 
-  //if bst is empty
-  if(bst == NULL) {
-    return 0;
+  node_update(node);
+  int balance = node_height(node->left) - node_height(node->right);
+
+  //left side is too tall
+  if(balance > 1) {
+
+    //left-right case turns into the left-left case first
+    if(node_height(node->left->left) < node_height(node->left->right)) {
+      node->left = rotate_left(node->left);
+    }
+    return rotate_right(node);
   }
 
-  else {
-    return bst_count(bst->root);
+  //right side is too tall
+  if(balance < -1) {
+
+    //right-left case turns into the right-right case first
+    if(node_height(node->right->right) < node_height(node->right->left)) {
+      node->right = rotate_right(node->right);
+    }
+    return rotate_left(node);
   }
+
+  return node;
 }
 
 /*
- * This function should insert a new key/value pair into the BST.  The key
- * should be used to order the key/value pair with respect to the other data
- * stored in the BST.  The value should be stored along with the key, once the
- * right location in the tree is found.
- *
- * Params:
- *   bst - the BST into which a new key/value pair is to be inserted.  May not
- *     be NULL.
- *   key - an integer value that should be used to order the key/value pair
- *     being inserted with respect to the other data in the BST.
- *   value - the value being inserted into the BST.  This should be stored in
- *     the BST alongside the key.  Note that this parameter has type void*,
- *     which means that a pointer of any type can be passed.
+ * This function inserts a key/value pair into the subtree rooted at `node`
+ * and returns the new (rebalanced) root of that subtree.  Keys equal to a
+ * node's key go to its right, as in an unbalanced BST, unless `multimap` is 1,
+ * in which case the value is added to that node instead.
  */
-void bst_insert(struct bst* bst, int key, void* value) {  
-
-  //keeps track of previous node that's the parent
-  struct bst_node* parent;
-  
-  //new node
-  struct bst_node* child;
+static struct bst_node* avl_insert(struct bst_node* node, int key, void* value, int multimap) {
 
-  //if the tree is empty
-  if(bst->root == NULL) {
-    child = malloc(sizeof(struct bst_node));
-    bst->root = child;
+  //found the empty spot where the new node goes
+  if(node == NULL) {
+    struct bst_node* child = malloc(sizeof(struct bst_node));
     child->key = key;
     child->value = value;
+    child->height = 1;
+    child->size = 1;
+    child->count = 1;
+    child->sum = key;
     child->left = NULL;
     child->right = NULL;
+    return child;
   }
 
-  //tree has at least a root
-  else {
-
-    child = bst->root;
+  if(multimap && key == node->key) {
+    node_add_value(node, value);
+    node_update(node);
+    return node;
+  }
 
-    //runs until we find an empty place where we can add a node
-    while(child != NULL) {
-      
-      parent = child;
-      
-      //traverses to the left if key is less than curr node key
-      if(key < child->key) {
-        child = child->left;
-      }
+  if(key < node->key) {
+    node->left = avl_insert(node->left, key, value, multimap);
+  }
 
-      //travereses to the right if key is greater or equal than curr node key
-      else {
-        child = child->right;
-      }
-    } 
+  else {
+    node->right = avl_insert(node->right, key, value, multimap);
+  }
 
-    //new node
-    child = malloc(sizeof(struct bst_node));
-    child->key = key;
-    child->value = value;
-    child->right = NULL;
-    child->left = NULL;
+  return rebalance(node);
+}
 
-    //adds to left
-    if(key < parent->key) {
-      parent->left = child;
-    }
+/*
+ * This function unlinks the node with the smallest key from the subtree
+ * rooted at `node`, storing it in `min`, and returns the new (rebalanced)
+ * root of that subtree.
+ */
+static struct bst_node* avl_remove_min(struct bst_node* node, struct bst_node** min) {
 
-    //adds to right
-    else {
-      parent->right = child;
-    }
+  if(node->left == NULL) {
+    *min = node;
+    return node->right;
   }
+
+  node->left = avl_remove_min(node->left, min);
+
+  return rebalance(node);
 }
 
 /*
- * This function should remove a key/value pair with a specified key from a
- * given BST.  If multiple values with the same key exist in the tree, this
- * function should remove the first one it encounters (i.e. the one closest to
- * the root of the tree).
- *
- * Params:
- *   bst - the BST from which a key/value pair is to be removed.  May not
- *     be NULL.
- *   key - the key of the key/value pair to be removed from the BST.
+ * This function removes the first node with the given key found on the way
+ * down from `node` (i.e. the one closest to the root) and returns the new
+ * (rebalanced) root of the subtree.  A node with two children is replaced by
+ * its in-order successor.  If the node holds more than one value, only its
+ * last value is removed and the node stays.  `removed` is set to 1 if a value
+ * was removed.
  */
-void bst_remove(struct bst* bst, int key) { 
-
-  //parent node
-  struct bst_node* parent = NULL;
-  
-  //current node that traverses until finds wanted node
-  struct bst_node* current = bst->root;
+static struct bst_node* avl_remove(struct bst_node* node, int key, int* removed) {
 
-  //finds wanted node
-  while(current->key != key) {
+  //key isn't in the tree
+  if(node == NULL) {
+    return NULL;
+  }
 
-    parent = current; 
-    
-    //traverses left
-    if(key < current->key) {
-      current = current->left;
-    }
+  if(key < node->key) {
+    node->left = avl_remove(node->left, key, removed);
+  }
 
-    //traverses right
-    else{
-      current = current->right;
-    }
+  else if(key > node->key) {
+    node->right = avl_remove(node->right, key, removed);
   }
 
-  //no children
-  if(current->right == NULL && current->left == NULL) {
-    
-    //if curr is left child
-    if(key < parent->key) {
-      parent->left = NULL;
+  else {
+    struct bst_node* replacement;
+    *removed = 1;
+
+    //a multimap node with values to spare just loses one
+    if(node->count > 1) {
+      node_remove_value(node);
+      node_update(node);
+      return node;
     }
 
-    //if curr is right child
-    else {
-      parent->right = NULL;
+    //zero or one children: the child (if any) takes the node's place
+    if(node->left == NULL || node->right == NULL) {
+      replacement = (node->left != NULL) ? node->left : node->right;
+      free(node);
+      return replacement;
     }
+
+    //two children: the successor takes the node's place
+    node->right = avl_remove_min(node->right, &replacement);
+    replacement->left = node->left;
+    replacement->right = node->right;
+    free(node);
+    node = replacement;
   }
 
-  //one child
-  else if(current->right == NULL || current->left == NULL) {
+  return rebalance(node);
+}
 
-    //left children of parent is the removed node
-    if(key < parent->key) {
+/*
+ * This function should allocate and initialize a new, empty, BST and return
+ * a pointer to it.
+ */
+struct bst* bst_create() {
+  
+  struct bst* bst = malloc(sizeof(struct bst));
+  bst->root = NULL;
+  bst->size = 0;
+  bst->multimap = 0;
+  bst->version = 0;
 
-      //removed node has a left children
-      if(current->left != NULL) {
-        parent->left = current->left;
-      }
+  return bst;
+}
 
-      //removed node has a right children
-      else {
-        parent->left = current->right;
-      }
-    }
+/*
+ * This function allocates a new, empty BST in multimap mode.  In a multimap,
+ * all the values inserted with the same key are kept together in one node
+ * instead of each getting a node of their own, so a key that repeats many
+ * times costs one node plus one pointer per value and doesn't make the tree
+ * any deeper.  bst_get_all() returns all of a key's values at once.
+ *
+ * Everything else works the same as in a normal BST: bst_size() counts
+ * values, and sums, ranks and iterators count a key once per value.
+ */
+struct bst* bst_create_multimap() {
 
-    //right children of parent is the removed node 
-    else {
+  struct bst* bst = bst_create();
+  bst->multimap = 1;
 
-      //removed node has a left children
-      if(current->left != NULL) {
-        parent->right = current->left;
-      }
+  return bst;
+}
 
-      //removed node has a right children
-      else {
-        parent->right = current->right;
-      }
-    }
+/*
+ * This function builds a perfectly balanced subtree out of the sorted keys
+ * keys[lo] through keys[hi - 1] (and their values) and returns its root.  The
+ * middle key becomes the root and each half becomes one of its subtrees, so
+ * every node is visited exactly once.  The subtree heights differ by at most
+ * one everywhere, so the result is a valid AVL tree.
+ */
+static struct bst_node* build_sorted(int* keys, void** values, int lo, int hi) {
+
+  if(lo >= hi) {
+    return NULL;
   }
-  
-  //two children
-  else {
 
-    //successor node
-    struct bst_node* successor = current->right;
+  int mid = lo + (hi - lo) / 2;
 
-    //parent of successor
-    struct bst_node* sp = parent;
-  
-    //finds successor node
-    while(successor->left != NULL) {
-      sp = successor;
-      successor = successor->left;
-    }
+  struct bst_node* node = malloc(sizeof(struct bst_node));
+  node->key = keys[mid];
+  node->value = (values != NULL) ? values[mid] : NULL;
+  node->count = 1;
+  node->left = build_sorted(keys, values, lo, mid);
+  node->right = build_sorted(keys, values, mid + 1, hi);
+  node_update(node);
 
-    //transfers children from curr to successor and successor to parent if needed
-    if(current->left != successor) {
-      successor->left = current->left;
-    }
+  return node;
+}
 
-    sp->left = successor->right;
-    
-    if(current->right != successor) {
-      successor->right = current->right;
-    }
+/*
+ * This structure holds the arguments for building one subtree of a sorted
+ * bulk load on its own thread, along with the resulting subtree.
+ */
+struct build_task {
+  int* keys;
+  void** values;
+  int lo;
+  int hi;
+  int threads;
+  struct bst_node* root;
+};
 
-    //if root was removed
-    if(current == bst->root) {
-      bst->root = successor;
-    }
+/*
+ * This function does the same thing as build_sorted(), but while there is more
+ * than one thread to spare it builds the left subtree on a new thread and the
+ * right subtree on the current one.  It is passed a `struct build_task`.
+ */
+static void* build_sorted_parallel(void* arg) {
 
-    //if parent's left child was removed
-    else if(successor->key < sp->key) {
-      sp->left = successor;
-    }
+  struct build_task* task = arg;
 
-    //if parent's right child was removed
-    else {
-      sp->right = successor;
-    }
+  //out of threads (or too little work), so the rest is built sequentially
+  if(task->threads <= 1 || task->hi - task->lo < 2) {
+    task->root = build_sorted(task->keys, task->values, task->lo, task->hi);
+    return NULL;
+  }
+
+  int mid = task->lo + (task->hi - task->lo) / 2;
+
+  struct build_task left = {task->keys, task->values, task->lo, mid, task->threads / 2, NULL};
+  struct build_task right = {task->keys, task->values, mid + 1, task->hi, task->threads - task->threads / 2, NULL};
+
+  //builds the left half on another thread, or here if no thread is available
+  pthread_t thread;
+  int spawned = pthread_create(&thread, NULL, build_sorted_parallel, &left) == 0;
+  if(!spawned) {
+    build_sorted_parallel(&left);
+  }
+  build_sorted_parallel(&right);
+  if(spawned) {
+    pthread_join(thread, NULL);
   }
 
-  free(current);
+  struct bst_node* node = malloc(sizeof(struct bst_node));
+  node->key = task->keys[mid];
+  node->value = (task->values != NULL) ? task->values[mid] : NULL;
+  node->count = 1;
+  node->left = left.root;
+  node->right = right.root;
+  node_update(node);
+
+  task->root = node;
+
+  return NULL;
 }
 
 /*
- * This function should return the value associated with a specified key in a
- * given BST.  If multiple values with the same key exist in the tree, this
- * function should return the first one it encounters (i.e. the one closest to
- * the root of the tree).  If the BST does not contain the specified key, this
- * function should return NULL.
+ * This function allocates a new BST holding the given keys and values.  The
+ * keys must already be in sorted (non-decreasing) order, which lets the tree
+ * be built perfectly balanced in O(n) time instead of the O(n log n) it would
+ * take to call bst_insert() on each key.
  *
  * Params:
- *   bst - the BST from which a key/value pair is to be removed.  May not
- *     be NULL.
- *   key - the key of the key/value pair whose value is to be returned.
+ *   keys - the keys to store, in sorted order.  May be NULL if `n` is 0.
+ *   values - the values to store, where values[i] goes with keys[i].  May be
+ *     NULL, in which case every value is NULL.
+ *   n - the number of keys.
  *
  * Return:
- *   Should return the value associated with the key `key` in `bst` or NULL,
- *   if the key `key` was not found in `bst`.
+ *   Should return a new BST containing the `n` key/value pairs.
  */
-void* bst_get(struct bst* bst, int key) {
+struct bst* bst_create_from_sorted(int* keys, void** values, int n) {
 
-  struct bst_node* current = bst->root;
+  struct bst* bst = bst_create();
+  bst->root = build_sorted(keys, values, 0, n);
+  bst->size = n;
 
-  //loops through the whole bst either finding the value or not
-  while(current != NULL) {
+  return bst;
+}
 
-    //node found
-    if(current->key == key) {
-      return current->value;
-    }
+/*
+ * This function does the same thing as bst_create_from_sorted(), but builds
+ * separate subtrees on separate threads.  The result is exactly the same tree.
+ *
+ * Params:
+ *   keys - the keys to store, in sorted order.  May be NULL if `n` is 0.
+ *   values - the values to store, where values[i] goes with keys[i].  May be
+ *     NULL, in which case every value is NULL.
+ *   n - the number of keys.
+ *   threads - the number of threads to use, including the calling thread.
+ *
+ * Return:
+ *   Should return a new BST containing the `n` key/value pairs.
+ */
+struct bst* bst_create_from_sorted_parallel(int* keys, void** values, int n, int threads) {
 
-    //travereses left if key is less than curr key
-    else if(key < current->key) {
-      current = current->left;
-    }
+  struct build_task task = {keys, values, 0, n, threads, NULL};
+  build_sorted_parallel(&task);
 
-    //traverses right if key greater than or equal to curr key
-    else{
-      current = current->right;
-    }
-  }
-  
-  return NULL;
+  struct bst* bst = bst_create();
+  bst->root = task.root;
+  bst->size = n;
+
+  return bst;
 }
 
-/*****************************************************************************
- **
- ** BST puzzle functions
- **
- *****************************************************************************/
 /*
- * This function finds the maximum depth of the tree
+ * This function frees up all the memory allocated to the nodes in the bst.  It
+ * doesn't recurse or use a stack: whenever the current node has a left child,
+ * the tree is rotated right so that child moves up, and once there is no left
+ * child the node is freed and its right child is next.  This turns the tree
+ * into a chain that is freed as it is walked.
  *
  * Params:
- *   bst - the root of the bst we're trying to find the height of and then iterating through all the nodes
- *
- * Return:
- *   Should return the height of bst.
+ *   node - the root of the subtree to free.  May be NULL.
  */
-int maxDepth(struct bst_node* root) {
-
-    //one count for left tree another for the right
-    int count = 0;
-    int count1 = 0;
-    
-    //if the tree is empty
-    if(root == NULL) {
-        return -1;
-    }  
-
-    //traverses left tree
-    if(root->left != NULL) {
-        count++;
-        count = count + maxDepth(root->left);
-    }
+static void node_free(struct bst_node* node) {
 
-    //traverses right tree
-    if(root->right != NULL) {
-        count1++;
-        count1 = count1 + maxDepth(root->right);
-    }
+  while(node != NULL) {
 
-    //returns the highest level, left side or right side
-    if(count > count1) {
-        return count;
+    //rotates the left child up so the tree leans right
+    if(node->left != NULL) {
+      struct bst_node* left = node->left;
+      node->left = left->right;
+      left->right = node;
+      node = left;
     }
 
+    //no left child, so the node can go and its right child is next
     else {
-        return count1;
+      struct bst_node* right = node->right;
+      if(node->count > 1) {
+        free(node->value);
+      }
+      free(node);
+      node = right;
     }
+  }
 }
 
 /*
- * This function should return the height of a given BST, which is the maximum
- * depth of any node in the tree (i.e. the number of edges in the path from
- * the root to that node).  Note that the height of an empty tree is -1 by
- * convention.
+ * This function should free the memory associated with a BST.  While this
+ * function should up all memory used in the BST itself, it should not free
+ * any memory allocated to the pointer values stored in the BST.  This is the
+ * responsibility of the caller.
  *
  * Params:
- *   bst - the BST whose height is to be computed
- *
- * Return:
+ *   bst - the BST to be destroyed.  May not be NULL.
+ */
+void bst_free(struct bst* bst) {
+
+  //frees all memory allocated to the nodes in the bst
+  node_free(bst->root);
+
+  //frees the bst itself
+  free(bst);
+  bst = NULL;
+}
+
+/*
+ * This function should return the total number of elements stored in a given
+ * BST.
+ *
+ * Params:
+ *   bst - the BST whose elements are to be counted.  May not be NULL.
+ */
+int bst_size(struct bst* bst) {
+
+  //if bst is empty
+  if(bst == NULL) {
+    return 0;
+  }
+
+  else {
+    return bst->size;
+  }
+}
+
+/*
+ * This function should insert a new key/value pair into the BST.  The key
+ * should be used to order the key/value pair with respect to the other data
+ * stored in the BST.  The value should be stored along with the key, once the
+ * right location in the tree is found.
+ *
+ * Params:
+ *   bst - the BST into which a new key/value pair is to be inserted.  May not
+ *     be NULL.
+ *   key - an integer value that should be used to order the key/value pair
+ *     being inserted with respect to the other data in the BST.
+ *   value - the value being inserted into the BST.  This should be stored in
+ *     the BST alongside the key.  Note that this parameter has type void*,
+ *     which means that a pointer of any type can be passed.
+ */
+void bst_insert(struct bst* bst, int key, void* value) {
+  bst->root = avl_insert(bst->root, key, value, bst->multimap);
+  bst->size++;
+  bst->version++;
+}
+
+/*
+ * This function should remove a key/value pair with a specified key from a
+ * given BST.  If multiple values with the same key exist in the tree, this
+ * function should remove the first one it encounters (i.e. the one closest to
+ * the root of the tree).  In a multimap, the value most recently inserted
+ * with the key is removed.
+ *
+ * Params:
+ *   bst - the BST from which a key/value pair is to be removed.  May not
+ *     be NULL.
+ *   key - the key of the key/value pair to be removed from the BST.  If the
+ *     key isn't in the BST, nothing happens.
+ */
+void bst_remove(struct bst* bst, int key) {
+  int removed = 0;
+  bst->root = avl_remove(bst->root, key, &removed);
+  bst->size -= removed;
+  bst->version++;
+}
+
+/*
+ * This function should return the value associated with a specified key in a
+ * given BST.  If multiple values with the same key exist in the tree, this
+ * function should return the first one it encounters (i.e. the one closest to
+ * the root of the tree).  In a multimap, the first value inserted with the key
+ * is returned.  If the BST does not contain the specified key, this function
+ * should return NULL.
+ *
+ * Params:
+ *   bst - the BST from which a key/value pair is to be removed.  May not
+ *     be NULL.
+ *   key - the key of the key/value pair whose value is to be returned.
+ *
+ * Return:
+ *   Should return the value associated with the key `key` in `bst` or NULL,
+ *   if the key `key` was not found in `bst`.
+ */
+void* bst_get(struct bst* bst, int key) {
+
+  struct bst_node* current = bst->root;
+
+  //loops through the whole bst either finding the value or not
+  while(current != NULL) {
+
+    //node found
+    if(current->key == key) {
+      return node_values(current)[0];
+    }
+
+    //travereses left if key is less than curr key
+    else if(key < current->key) {
+      current = current->left;
+    }
+
+    //traverses right if key greater than or equal to curr key
+    else{
+      current = current->right;
+    }
+  }
+  
+  return NULL;
+}
+
+/*
+ * This function looks up many keys in a BST at once, storing the value for
+ * keys[i] in out[i] (or NULL if the key isn't in the BST), just as if
+ * bst_get() were called on each key.
+ *
+ * Each step down the tree in bst_get() has to wait for the next node to come
+ * in from memory before it can compare against it.  This function instead
+ * keeps GET_MANY_BATCH lookups going at once and advances them in turns.
+ * Whenever one lookup moves to a child, it asks for that child to be
+ * prefetched, and by the time its turn comes around again the child is
+ * likely to be in cache.  As lookups finish, new ones take their place.
+ *
+ * Params:
+ *   bst - the BST to search.  May not be NULL.
+ *   keys - the keys to look up.
+ *   n - the number of keys.
+ *   out - array of at least `n` elements in which to store the values.
+ */
+void bst_get_many(struct bst* bst, int* keys, int n, void** out) {
+
+  struct bst_node* current[GET_MANY_BATCH];
+  int index[GET_MANY_BATCH];
+  int active = 0;
+  int next = 0;
+
+  //starts the first batch of lookups at the root
+  while(active < GET_MANY_BATCH && next < n) {
+    current[active] = bst->root;
+    index[active] = next++;
+    active++;
+  }
+
+  while(active > 0) {
+
+    for(int slot = 0; slot < active; ) {
+
+      struct bst_node* node = current[slot];
+      int key = keys[index[slot]];
+
+      //the lookup isn't done yet, so it moves one level down
+      if(node != NULL && node->key != key) {
+        node = (key < node->key) ? node->left : node->right;
+        PREFETCH(node);
+        current[slot] = node;
+        slot++;
+        continue;
+      }
+
+      //the lookup is done, either found or off the bottom of the tree
+      out[index[slot]] = (node != NULL) ? node_values(node)[0] : NULL;
+
+      //a new lookup takes over the slot
+      if(next < n) {
+        current[slot] = bst->root;
+        index[slot] = next++;
+        slot++;
+      }
+
+      //no lookups are left to start, so the last active slot fills the gap
+      else {
+        active--;
+        current[slot] = current[active];
+        index[slot] = index[active];
+      }
+    }
+  }
+}
+
+/*
+ * This function returns all the values stored with a key in a BST, in the
+ * order they were inserted.  The returned array belongs to the BST and is only
+ * valid until the BST is next changed.  In a BST that isn't a multimap, only
+ * the first value found (the one bst_get() returns) is included.  Takes
+ * O(log n) time.
+ *
+ * Params:
+ *   bst - the BST to search.  May not be NULL.
+ *   key - the key whose values are to be returned.
+ *   n - pointer at which to store the number of values returned.  May not be
+ *     NULL.
+ *
+ * Return:
+ *   Should return an array of the `*n` values stored with `key`, or NULL (with
+ *   `*n` set to 0) if `key` isn't in the BST.
+ */
+void** bst_get_all(struct bst* bst, int key, int* n) {
+
+  struct bst_node* current = bst->root;
+
+  while(current != NULL && current->key != key) {
+    current = (key < current->key) ? current->left : current->right;
+  }
+
+  if(current == NULL) {
+    *n = 0;
+    return NULL;
+  }
+
+  *n = current->count;
+  return node_values(current);
+}
+
+/*****************************************************************************
+ **
+ ** BST puzzle functions
+ **
+ *****************************************************************************/
+/*
+ * This function should return the height of a given BST, which is the maximum
+ * depth of any node in the tree (i.e. the number of edges in the path from
+ * the root to that node).  Note that the height of an empty tree is -1 by
+ * convention.
+ *
+ * Params:
+ *   bst - the BST whose height is to be computed
+ *
+ * Return:
  *   Should return the height of bst.
  */
  int bst_height(struct bst* bst) {
-    return maxDepth(bst->root);
+
+    //each node stores the height of its subtree, counting nodes rather than edges
+    return node_height(bst->root) - 1;
  }
 
 /*
@@ -492,61 +850,140 @@ int bst_path_sum(struct bst* bst, int sum) {
 }
 
 /*
- * This function computes the sum of all the nodes in the given range 
+ * This function does the same search as add(), but gives up as soon as
+ * `found` is set by another thread searching a different part of the tree.
+ */
+static int add_shared(struct bst_node* node, int sum, int* found) {
+
+  if(node == NULL || __atomic_load_n(found, __ATOMIC_RELAXED)) {
+    return 0;
+  }
+
+  sum -= node->key;
+
+  if(node->left == NULL && node->right == NULL && sum == 0) {
+    __atomic_store_n(found, 1, __ATOMIC_RELAXED);
+    return 1;
+  }
+
+  return add_shared(node->left, sum, found) || add_shared(node->right, sum, found);
+}
+
+/*
+ * This structure holds the inputs of a path sum search of one subtree, which
+ * may run on its own thread.  `found` is shared by every search in the same
+ * call so they can all stop once one of them finds a path.
+ */
+struct path_sum_task {
+  struct bst_node* node;
+  int sum;
+  int threads;
+  int* found;
+};
+
+/*
+ * This function searches the subtree `task->node` for a path adding up to
+ * `task->sum`, setting `*task->found` if there is one.  While there is more
+ * than one thread to spare and the subtree is big enough, the left subtree
+ * is searched on a new thread and the right one on the current thread.  It is
+ * passed a `struct path_sum_task`.
+ */
+static void* path_sum_parallel(void* arg) {
+
+  struct path_sum_task* task = arg;
+  struct bst_node* node = task->node;
+
+  //out of threads (or too little work), so the rest is searched sequentially;
+  //leaves go this way too, since in a multimap one leaf can hold more values
+  //than the cutoff
+  if(node == NULL || task->threads <= 1 || node_size(node) < PATH_SUM_CUTOFF ||
+      (node->left == NULL && node->right == NULL)) {
+    add_shared(node, task->sum, task->found);
+    return NULL;
+  }
+
+  int sum = task->sum - node->key;
+  struct path_sum_task left = {node->left, sum, task->threads / 2, task->found};
+  struct path_sum_task right = {node->right, sum, task->threads - task->threads / 2, task->found};
+
+  pthread_t thread;
+  int spawned = pthread_create(&thread, NULL, path_sum_parallel, &left) == 0;
+  if(!spawned) {
+    path_sum_parallel(&left);
+  }
+  path_sum_parallel(&right);
+  if(spawned) {
+    pthread_join(thread, NULL);
+  }
+
+  return NULL;
+}
+
+/*
+ * This function returns the same result as bst_path_sum(), but searches
+ * large subtrees on separate threads.  Every path has to be checked when
+ * there is no match, so this is the one BST query whose cost grows with the
+ * size of the tree.  The threads stop as soon as any of them finds a path.
  *
  * Params:
- *   node - current node we are iterating through, should be the root at the start
- *   lower - the lower bound of the range over which to compute a sum; this
- *     should be considered an *inclusive* bound; in other words a key that's
- *     equal to this bound should be included in the sum
- *   upper - the upper bound of the range over which to compute a sum; this
- *     should be considered an *inclusive* bound; in other words a key that's
- *     equal to this bound should be included in the sum
+ *   bst - the BST whose paths sums to search.  May not be NULL.
+ *   sum - the value to search for among the path sums of `bst`.
+ *   threads - the largest number of threads to use.  1 runs on the calling
+ *     thread only.
  *
  * Return:
- *   Should return the sum of all keys in the bst between `lower` and `upper`.
+ *   Should return 1 if `bst` contains any path from the root to a leaf in
+ *   which the keys add up to `sum`.  Should return 0 otherwise.
  */
-int range(struct bst_node* node, int lower, int upper) {
-  
-  int count = 0;
+int bst_path_sum_parallel(struct bst* bst, int sum, int threads) {
 
-  //checks if node fits inside the range
-  if(node->key >= lower && node->key <= upper) {
-    count += node->key;
-  }
+  int found = 0;
+  struct path_sum_task task = {bst->root, sum, threads, &found};
+  path_sum_parallel(&task);
 
-  //checks if there is a left node
-  if(node->left != NULL) {
+  return found;
+}
 
-    //checks if the left node is higher than the lower limit
-    if(node->left->key >= lower) {
-      count += range(node->left, lower, upper);
-    }
+/*
+ * This function counts the keys in the subtree rooted at `node` that are less
+ * than `key` (or less than or equal to `key` if `inclusive` is 1), and adds up
+ * those keys.  Only one path from the root is followed: whenever the walk goes
+ * right, the node and its whole left subtree are counted at once using their
+ * stored size and sum.
+ *
+ * Params:
+ *   node - the root of the subtree to search.  May be NULL.
+ *   key - the bound to compare keys against.
+ *   inclusive - 1 if keys equal to `key` should be counted, 0 otherwise.
+ *   sum - if not NULL, set to the sum of the counted keys.
+ *
+ * Return:
+ *   Returns the number of keys counted.
+ */
+static int prefix(struct bst_node* node, int key, int inclusive, long long* sum) {
 
-    //if the left node is lower than lower limit, check to see if it has a right child and if that right child is higher than the lower limit
-    else if(node->left->right != NULL) {
-      if(node->left->right->key >= lower) {
-        count += range(node->left->right, lower, upper);
-      }
-    }
-  }
+  int count = 0;
+  long long total = 0;
 
-  //checks if there is a right node
-  if(node->right != NULL) {
+  while(node != NULL) {
 
-    //checks if the right node is lower than the upper limit
-    if(node->right->key <= upper) {
-      count += range(node->right, lower, upper);
+    //the node and everything to its left are in the prefix
+    if(node->key < key || (inclusive && node->key == key)) {
+      count += node_size(node->left) + node->count;
+      total += node_sum(node->left) + (long long)node->key * node->count;
+      node = node->right;
     }
 
-    //if the right node is higher than the upper limit, check to see if it has a left child and if that left child is lower than the upper limit
-    else if(node->right->left != NULL) {
-      if(node->right->left->key <= upper) {
-        count += range(node->right->left, lower, upper);
-      }
+    //nothing to the right of the node can be in the prefix
+    else {
+      node = node->left;
     }
   }
 
+  if(sum != NULL) {
+    *sum = total;
+  }
+
   return count;
 }
 
@@ -556,6 +993,9 @@ int range(struct bst_node* node, int lower, int upper) {
  * and a given upper bound.  For full credit, you should not process any subtree
  * whose keys cannot be included in the range sum.
  *
+ * Since every node stores the sum of the keys in its subtree, this only needs
+ * to follow the search paths for the two bounds, so it runs in O(log n) time.
+ *
  * Params:
  *   bst - the BST within which to compute a range sum
  *   lower - the lower bound of the range over which to compute a sum; this
@@ -569,6 +1009,475 @@ int range(struct bst_node* node, int lower, int upper) {
  *   Should return the sum of all keys in `bst` between `lower` and `upper`.
  */
 int bst_range_sum(struct bst* bst, int lower, int upper) {
-  return range(bst->root, lower, upper);
+
+  long long below, through;
+
+  if(lower > upper) {
+    return 0;
+  }
+
+  //keys in [lower, upper] are the keys <= upper minus the keys < lower
+  prefix(bst->root, lower, 0, &below);
+  prefix(bst->root, upper, 1, &through);
+
+  return (int)(through - below);
+}
+
+/*****************************************************************************
+ **
+ ** BST order statistics functions
+ **
+ *****************************************************************************/
+
+/*
+ * This function returns the rank of a key in a given BST, i.e. the number of
+ * keys in the BST that are less than it.  The key itself doesn't need to be in
+ * the BST.  Runs in O(log n) time.
+ *
+ * Params:
+ *   bst - the BST to search.  May not be NULL.
+ *   key - the key whose rank is to be found.
+ *
+ * Return:
+ *   Should return the number of keys in `bst` that are less than `key`.
+ */
+int bst_rank(struct bst* bst, int key) {
+  return prefix(bst->root, key, 0, NULL);
+}
+
+/*
+ * This function finds the key with a given rank in a BST, i.e. the k-th
+ * smallest key counting from 0.  Runs in O(log n) time.
+ *
+ * Params:
+ *   bst - the BST to search.  May not be NULL.
+ *   k - the rank of the key to find.  Must be between 0 (inclusive) and the
+ *     size of the BST (exclusive).
+ *   value - if not NULL, set to the value stored with the key that's found.
+ *
+ * Return:
+ *   Should return the k-th smallest key in `bst`.
+ */
+int bst_select(struct bst* bst, int k, void** value) {
+
+  struct bst_node* current = bst->root;
+
+  while(current != NULL) {
+
+    int left = node_size(current->left);
+
+    //the key is in the left subtree
+    if(k < left) {
+      current = current->left;
+    }
+
+    //the key is in the right subtree, after skipping the left one and this node
+    else if(k >= left + current->count) {
+      k -= left + current->count;
+      current = current->right;
+    }
+
+    //this node is the k-th key
+    else {
+      break;
+    }
+  }
+
+  if(value != NULL) {
+    *value = node_values(current)[k - node_size(current->left)];
+  }
+
+  return current->key;
+}
+
+/*
+ * This function counts the keys in a given BST that are between a lower bound
+ * and an upper bound (both inclusive).  Runs in O(log n) time.
+ *
+ * Params:
+ *   bst - the BST to search.  May not be NULL.
+ *   lower - the inclusive lower bound of the range.
+ *   upper - the inclusive upper bound of the range.
+ *
+ * Return:
+ *   Should return the number of keys in `bst` between `lower` and `upper`.
+ */
+int bst_count_range(struct bst* bst, int lower, int upper) {
+
+  if(lower > upper) {
+    return 0;
+  }
+
+  return prefix(bst->root, upper, 1, NULL) - prefix(bst->root, lower, 0, NULL);
+}
+
+/*****************************************************************************
+ **
+ ** BST iterator definition and functions
+ **
+ *****************************************************************************/
+
+/*
+ * Structure used to represent a binary search tree iterator.  It holds the
+ * nodes on the path from the root to the next node to be returned whose keys
+ * haven't been returned yet, with the next node on top.  Because the tree is
+ * balanced, that path fits in a fixed-size array, so stepping the iterator
+ * never allocates memory.
+ *
+ * A forward iterator returns keys in increasing order and stops once it
+ * passes `upper`; a reverse iterator returns keys in decreasing order and
+ * stops once it passes `lower`.  The root is kept so the iterator can seek.
+ * `index` is the number of values of the node on top that have already been
+ * returned, since a multimap node returns its key once per value.
+ */
+struct bst_iterator {
+  struct bst_node* stack[BST_MAX_HEIGHT];
+  int top;
+  int index;
+  struct bst_node* root;
+  int reverse;
+  int lower;
+  int upper;
+};
+
+/*
+ * This function pushes `node` and its chain of children towards the start of
+ * the iteration order (left children for a forward iterator, right children
+ * for a reverse one) onto an iterator's stack, which leaves the first key of
+ * that subtree on top.
+ */
+static void push_spine(struct bst_iterator* iter, struct bst_node* node) {
+  while(node != NULL) {
+    iter->stack[iter->top++] = node;
+    node = iter->reverse ? node->right : node->left;
+  }
+}
+
+/*
+ * This function fills an iterator's stack so that the next key returned is
+ * the first one at or after `key` in iteration order (i.e. the smallest key
+ * >= `key` for a forward iterator, or the largest key <= `key` for a reverse
+ * one).  Only the path from the root to that key is visited, so this takes
+ * O(log n) time.
+ */
+static void seek_from_root(struct bst_iterator* iter, int key) {
+
+  struct bst_node* node = iter->root;
+  iter->top = 0;
+  iter->index = 0;
+
+  while(node != NULL) {
+
+    //the node comes at or after `key`, so it's pending and we look for earlier ones
+    if(iter->reverse ? node->key <= key : node->key >= key) {
+      iter->stack[iter->top++] = node;
+      node = iter->reverse ? node->right : node->left;
+    }
+
+    //the node and everything before it are skipped
+    else {
+      node = iter->reverse ? node->left : node->right;
+    }
+  }
+}
+
+/*
+ * This function allocates an iterator over the keys of `bst` between `lower`
+ * and `upper`, in the direction given by `reverse`, positioned at the first
+ * key in range.
+ */
+static struct bst_iterator* iterator_create(struct bst* bst, int reverse, int lower, int upper) {
+
+  struct bst_iterator* iter = malloc(sizeof(struct bst_iterator));
+  iter->top = 0;
+  iter->root = bst->root;
+  iter->reverse = reverse;
+  iter->lower = lower;
+  iter->upper = upper;
+
+  seek_from_root(iter, reverse ? upper : lower);
+
+  return iter;
+}
+
+/*
+ * This function should allocate and initialize a new in-order BST iterator
+ * given a specific BST over which to iterate.
+ *
+ * Params:
+ *   bst - the BST for over which to create an iterator.  May not be NULL.
+ */
+struct bst_iterator* bst_iterator_create(struct bst* bst) {
+
+  return iterator_create(bst, 0, INT_MIN, INT_MAX);
 }
 
+/*
+ * This function allocates an in-order iterator over only the keys of a BST
+ * that are between `lower` and `upper` (both inclusive).  It starts at the
+ * smallest key >= `lower` without visiting any smaller keys, and stops after
+ * the largest key <= `upper`, so iterating over a small range of a big tree
+ * takes O(log n + k) time for k keys in range.
+ *
+ * Params:
+ *   bst - the BST over which to create an iterator.  May not be NULL.
+ *   lower - the inclusive lower bound of the keys to return.
+ *   upper - the inclusive upper bound of the keys to return.
+ */
+struct bst_iterator* bst_iterator_create_range(struct bst* bst, int lower, int upper) {
+  return iterator_create(bst, 0, lower, upper);
+}
+
+/*
+ * This function allocates an iterator that returns the keys of a BST in
+ * reverse (decreasing) order.
+ *
+ * Params:
+ *   bst - the BST over which to create an iterator.  May not be NULL.
+ */
+struct bst_iterator* bst_iterator_create_reverse(struct bst* bst) {
+  return iterator_create(bst, 1, INT_MIN, INT_MAX);
+}
+
+/*
+ * This function allocates an iterator that returns the keys of a BST between
+ * `lower` and `upper` (both inclusive) in reverse (decreasing) order, starting
+ * at the largest key <= `upper`.
+ *
+ * Params:
+ *   bst - the BST over which to create an iterator.  May not be NULL.
+ *   lower - the inclusive lower bound of the keys to return.
+ *   upper - the inclusive upper bound of the keys to return.
+ */
+struct bst_iterator* bst_iterator_create_reverse_range(struct bst* bst, int lower, int upper) {
+  return iterator_create(bst, 1, lower, upper);
+}
+
+/*
+ * This function moves an iterator so that the next key it returns is the
+ * first key at or after `key` in its direction: the smallest key >= `key` for
+ * a forward iterator, or the largest key <= `key` for a reverse one.  The
+ * iterator's range still applies.  Takes O(log n) time.
+ *
+ * Params:
+ *   iter - the iterator to move.  May not be NULL.
+ *   key - the key to move to.
+ */
+void bst_iterator_seek(struct bst_iterator* iter, int key) {
+
+  //seeking to before the start of the range starts at the range
+  if(!iter->reverse && key < iter->lower) {
+    key = iter->lower;
+  }
+  else if(iter->reverse && key > iter->upper) {
+    key = iter->upper;
+  }
+
+  seek_from_root(iter, key);
+}
+
+/*
+ * This function should free all memory allocated to a given BST iterator.
+ * It should NOT free any memory associated with the BST itself.  This is the
+ * responsibility of the caller.
+ *
+ * Params:
+ *   iter - the BST iterator to be destroyed.  May not be NULL.
+ */
+void bst_iterator_free(struct bst_iterator* iter) {
+  free(iter);
+}
+
+/*
+ * This function should indicate whether a given BST iterator has more nodes
+ * to visit.  It should specifically return 1 (true) if the iterator has at
+ * least one more node to visit or 0 (false) if it does not have any more
+ * nodes to visit.
+ *
+ * Params:
+ *   iter - the BST iterator to be checked for remaining nodes to visit.  May
+ *     not be NULL.
+ */
+int bst_iterator_has_next(struct bst_iterator* iter) {
+
+  if(iter->top == 0) {
+    return 0;
+  }
+
+  //the next key must still be inside the iterator's range
+  int key = iter->stack[iter->top - 1]->key;
+  return iter->reverse ? key >= iter->lower : key <= iter->upper;
+}
+
+/*
+ * This function should return both the value and key associated with the
+ * current node pointed to by the specified BST iterator and advnce the
+ * iterator to point to the next node in the BST (in in-order order, or in
+ * reverse order for a reverse iterator).  It may only be called if
+ * bst_iterator_has_next() returns 1.
+ *
+ * Because a function can't return two things, the key associated with the
+ * current node should be returned the normal way, while its value should be
+ * returned via the argument `value`.  Specifically, the argument `value`
+ * is a pointer to a void pointer.  The current BST node's value (a void
+ * pointer) should be stored at the address represented by `value` (i.e. by
+ * dereferencing `value`).  This will look something like this:
+ *
+ *   *value = current_node->value;
+ *
+ * Params:
+ *   iter - BST iterator.  The key and value associated with this iterator's
+ *     current node should be returned, and the iterator should be updated to
+ *     point to the next node in the BST (in in-order order).  May not be NULL.
+ *   value - pointer at which the current BST node's value should be stored
+ *     before this function returns.
+ *
+ * Return:
+ *   This function should return the key associated with the current BST
+ *   node pointed to by `iter`.
+ */
+int bst_iterator_next(struct bst_iterator* iter, void** value) {
+
+  //the node on top of the stack is next in order
+  struct bst_node* node = iter->stack[iter->top - 1];
+
+  if(value != NULL) {
+    *value = node_values(node)[iter->index];
+  }
+
+  //once all of the node's values are returned, the key after it is the first
+  //key of its right subtree (left, if reversed)
+  if(++iter->index == node->count) {
+    iter->top--;
+    iter->index = 0;
+    push_spine(iter, iter->reverse ? node->left : node->right);
+  }
+
+  return node->key;
+}
+
+/*****************************************************************************
+ **
+ ** BST cursor definition and functions
+ **
+ *****************************************************************************/
+
+/*
+ * Structure used to represent a BST cursor, a "finger" that remembers the
+ * path from the root to the node where the last lookup ended.  path[i] is the
+ * node at depth i, and every key in its subtree is between lower[i] and
+ * upper[i].  The bounds are long longs so the root's can be wider than any
+ * int.  `version` is the BST's version when the path was saved.
+ */
+struct bst_cursor {
+  struct bst* bst;
+  unsigned long version;
+  int top;
+  struct bst_node* path[BST_MAX_HEIGHT];
+  long long lower[BST_MAX_HEIGHT];
+  long long upper[BST_MAX_HEIGHT];
+};
+
+/*
+ * This function allocates a cursor over a BST.  The cursor doesn't hold a
+ * path until its first lookup.
+ *
+ * Params:
+ *   bst - the BST to look keys up in.  May not be NULL.
+ */
+struct bst_cursor* bst_cursor_create(struct bst* bst) {
+
+  struct bst_cursor* cursor = malloc(sizeof(struct bst_cursor));
+  cursor->bst = bst;
+  cursor->version = bst->version;
+  cursor->top = 0;
+
+  return cursor;
+}
+
+/*
+ * This function frees the memory associated with a BST cursor.  It does not
+ * free the BST.
+ *
+ * Params:
+ *   cursor - the cursor to be destroyed.  May not be NULL.
+ */
+void bst_cursor_free(struct bst_cursor* cursor) {
+  free(cursor);
+}
+
+/*
+ * This function returns the value associated with a key, just as bst_get()
+ * does, but starts from where the cursor's last lookup ended instead of from
+ * the root.  It climbs the saved path only as far as the lowest node whose
+ * subtree has room for `key` between its bounds, and searches down from
+ * there.  When keys are looked up in nearly sorted order, successive keys are
+ * usually close together in the tree, so a run of lookups costs O(log d)
+ * amortized time each, where d is how many places apart successive keys are,
+ * rather than O(log n).  A single lookup can still cost O(log n): even two
+ * neighbouring keys can be on opposite sides of the root.
+ *
+ * If the BST was changed since the last lookup, the saved path may no longer
+ * be valid, so the lookup starts from the root again.
+ *
+ * Params:
+ *   cursor - the cursor to look the key up with.  May not be NULL.
+ *   key - the key whose value is to be returned.
+ *
+ * Return:
+ *   Should return the value associated with `key`, or NULL if `key` isn't in
+ *   the BST.
+ */
+void* bst_cursor_get(struct bst_cursor* cursor, int key) {
+
+  struct bst* bst = cursor->bst;
+
+  //starts over at the root if there is no path or the tree has changed
+  if(cursor->top == 0 || cursor->version != bst->version) {
+    cursor->version = bst->version;
+    cursor->top = 0;
+    if(bst->root == NULL) {
+      return NULL;
+    }
+    cursor->path[0] = bst->root;
+    cursor->lower[0] = LLONG_MIN;
+    cursor->upper[0] = LLONG_MAX;
+    cursor->top = 1;
+  }
+
+  //climbs until `key` is strictly inside a subtree's bounds, where a search
+  //from the root would pass through that subtree's root too
+  while(cursor->top > 1 && !(cursor->lower[cursor->top - 1] < key && key < cursor->upper[cursor->top - 1])) {
+    cursor->top--;
+  }
+
+  struct bst_node* node = cursor->path[cursor->top - 1];
+
+  while(node->key != key) {
+
+    int i = cursor->top;
+    struct bst_node* child;
+    cursor->lower[i] = cursor->lower[i - 1];
+    cursor->upper[i] = cursor->upper[i - 1];
+
+    if(key < node->key) {
+      child = node->left;
+      cursor->upper[i] = node->key;
+    }
+    else {
+      child = node->right;
+      cursor->lower[i] = node->key;
+    }
+
+    //the search ends here, and the path stays at the last node visited
+    if(child == NULL) {
+      return NULL;
+    }
+
+    cursor->path[i] = child;
+    cursor->top++;
+    node = child;
+  }
+
+  return node_values(node)[0];
+}
@@ -18,11 +18,16 @@ struct bst;
  * documentation about each of these functions.
  */
 struct bst* bst_create();
+struct bst* bst_create_multimap();
+struct bst* bst_create_from_sorted(int* keys, void** values, int n);
+struct bst* bst_create_from_sorted_parallel(int* keys, void** values, int n, int threads);
 void bst_free(struct bst* bst);
 int bst_size(struct bst* bst);
 void bst_insert(struct bst* bst, int key, void* value);
 void bst_remove(struct bst* bst, int key);
 void* bst_get(struct bst* bst, int key);
+void bst_get_many(struct bst* bst, int* keys, int n, void** out);
+void** bst_get_all(struct bst* bst, int key, int* n);
 
 /*
  * Binary search tree "puzzle" function prototypes.  Refer to bst.c for
@@ -30,8 +35,17 @@ void* bst_get(struct bst* bst, int key);
  */
 int bst_height(struct bst* bst);
 int bst_path_sum(struct bst* bst, int sum);
+int bst_path_sum_parallel(struct bst* bst, int sum, int threads);
 int bst_range_sum(struct bst* bst, int lower, int upper);
 
+/*
+ * Binary search tree order statistics function prototypes.  Refer to bst.c
+ * for documentation about each of these functions.
+ */
+int bst_rank(struct bst* bst, int key);
+int bst_select(struct bst* bst, int k, void** value);
+int bst_count_range(struct bst* bst, int lower, int upper);
+
 /*
  * Structure used to represent a binary search tree iterator.
  */
@@ -42,8 +56,25 @@ struct bst_iterator;
  * documentation about each of these functions.
  */
 struct bst_iterator* bst_iterator_create(struct bst* bst);
+struct bst_iterator* bst_iterator_create_range(struct bst* bst, int lower, int upper);
+struct bst_iterator* bst_iterator_create_reverse(struct bst* bst);
+struct bst_iterator* bst_iterator_create_reverse_range(struct bst* bst, int lower, int upper);
+void bst_iterator_seek(struct bst_iterator* iter, int key);
 void bst_iterator_free(struct bst_iterator* iter);
 int bst_iterator_has_next(struct bst_iterator* iter);
 int bst_iterator_next(struct bst_iterator* iter, void** value);
 
+/*
+ * Structure used to represent a binary search tree cursor.
+ */
+struct bst_cursor;
+
+/*
+ * Binary search tree cursor interface prototypes.  Refer to bst.c for
+ * documentation about each of these functions.
+ */
+struct bst_cursor* bst_cursor_create(struct bst* bst);
+void bst_cursor_free(struct bst_cursor* cursor);
+void* bst_cursor_get(struct bst_cursor* cursor, int key);
+
 #endif
@@ -0,0 +1,407 @@
+/*
+ * This file contains the implementation of a compact binary search tree.  It
+ * behaves like the BST in bst.c (an AVL tree where equal keys go to the right),
+ * but instead of allocating each node separately, all nodes live in a single
+ * array (the "arena") and refer to their children by 32-bit index rather than
+ * by pointer.  This makes each node 24 bytes (half the size of a bst.c node),
+ * keeps nodes close together in memory, and turns freeing the whole tree into
+ * a single free().
+ *
+ * Index 0 is never used for a real node, so it plays the role of NULL.
+ * Removed nodes are kept on a free list (linked through their `left` field)
+ * and reused by later inserts.
+ *
+ * Name: Gabriel de Leon
+ * Email: deleong@oregonstate.edu
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+
+#include "bst_compact.h"
+
+/*
+ * This is the index that stands for "no node".
+ */
+#define NIL 0
+
+/*
+ * This is the number of nodes the arena starts out with room for.
+ */
+#define INITIAL_CAPACITY 16
+
+/*
+ * This structure represents a single node in a compact BST.  `left` and
+ * `right` are indices into the arena, and `height` is the height of the
+ * subtree rooted at the node (1 for a leaf).
+ */
+struct bst_compact_node {
+  void* value;
+  int key;
+  uint32_t left;
+  uint32_t right;
+  uint8_t height;
+};
+
+/*
+ * This structure represents an entire compact BST.  `nodes` is the arena,
+ * which has room for `capacity` nodes, of which the first `used` have been
+ * handed out at some point.  `free_list` is the index of the first node that
+ * was removed and can be reused.
+ */
+struct bst_compact {
+  struct bst_compact_node* nodes;
+  uint32_t capacity;
+  uint32_t used;
+  uint32_t free_list;
+  uint32_t root;
+  int size;
+};
+
+/*
+ * This function returns the height of the subtree at index `i`, where an
+ * empty subtree has height 0.
+ */
+static int height(struct bst_compact* bst, uint32_t i) {
+  return i == NIL ? 0 : bst->nodes[i].height;
+}
+
+/*
+ * This function recomputes the stored height of a node from its children.
+ */
+static void update(struct bst_compact* bst, uint32_t i) {
+  int left = height(bst, bst->nodes[i].left);
+  int right = height(bst, bst->nodes[i].right);
+  bst->nodes[i].height = (left > right ? left : right) + 1;
+}
+
+/*
+ * These functions rotate the subtree at index `i` to the right or to the left
+ * and return the index of the new root of the subtree.
+ */
+static uint32_t rotate_right(struct bst_compact* bst, uint32_t i) {
+  uint32_t pivot = bst->nodes[i].left;
+  bst->nodes[i].left = bst->nodes[pivot].right;
+  bst->nodes[pivot].right = i;
+  update(bst, i);
+  update(bst, pivot);
+  return pivot;
+}
+
+static uint32_t rotate_left(struct bst_compact* bst, uint32_t i) {
+  uint32_t pivot = bst->nodes[i].right;
+  bst->nodes[i].right = bst->nodes[pivot].left;
+  bst->nodes[pivot].left = i;
+  update(bst, i);
+  update(bst, pivot);
+  return pivot;
+}
+
+/*
+ * This function restores the AVL property at the node at index `i` and
+ * returns the index of the new root of the subtree.
+ */
+static uint32_t rebalance(struct bst_compact* bst, uint32_t i) {
+
+  struct bst_compact_node* nodes = bst->nodes;
+
+  update(bst, i);
+  int balance = height(bst, nodes[i].left) - height(bst, nodes[i].right);
+
+  //left side is too tall
+  if(balance > 1) {
+    uint32_t left = nodes[i].left;
+    if(height(bst, nodes[left].left) < height(bst, nodes[left].right)) {
+      nodes[i].left = rotate_left(bst, left);
+    }
+    return rotate_right(bst, i);
+  }
+
+  //right side is too tall
+  if(balance < -1) {
+    uint32_t right = nodes[i].right;
+    if(height(bst, nodes[right].right) < height(bst, nodes[right].left)) {
+      nodes[i].right = rotate_right(bst, right);
+    }
+    return rotate_left(bst, i);
+  }
+
+  return i;
+}
+
+/*
+ * This function hands out an unused node from the arena, reusing a removed
+ * node if there is one and doubling the arena if it's full.  Since children
+ * are stored as indices, moving the arena doesn't break any links.
+ */
+static uint32_t node_alloc(struct bst_compact* bst) {
+
+  //reuses a removed node
+  if(bst->free_list != NIL) {
+    uint32_t i = bst->free_list;
+    bst->free_list = bst->nodes[i].left;
+    return i;
+  }
+
+  //grows the arena if needed
+  if(bst->used == bst->capacity) {
+    assert(bst->capacity <= UINT32_MAX / 2);
+    bst->capacity *= 2;
+    bst->nodes = realloc(bst->nodes, bst->capacity * sizeof(struct bst_compact_node));
+  }
+
+  return bst->used++;
+}
+
+/*
+ * This function puts a removed node on the free list.
+ */
+static void node_release(struct bst_compact* bst, uint32_t i) {
+  bst->nodes[i].left = bst->free_list;
+  bst->free_list = i;
+}
+
+/*
+ * This function links the already-initialized node at index `leaf` into the
+ * subtree at index `i` and returns the index of the new root of the subtree.
+ */
+static uint32_t insert(struct bst_compact* bst, uint32_t i, uint32_t leaf) {
+
+  if(i == NIL) {
+    return leaf;
+  }
+
+  if(bst->nodes[leaf].key < bst->nodes[i].key) {
+    bst->nodes[i].left = insert(bst, bst->nodes[i].left, leaf);
+  }
+
+  else {
+    bst->nodes[i].right = insert(bst, bst->nodes[i].right, leaf);
+  }
+
+  return rebalance(bst, i);
+}
+
+/*
+ * This function unlinks the node with the smallest key from the subtree at
+ * index `i`, storing its index in `min`, and returns the index of the new
+ * root of the subtree.
+ */
+static uint32_t remove_min(struct bst_compact* bst, uint32_t i, uint32_t* min) {
+
+  if(bst->nodes[i].left == NIL) {
+    *min = i;
+    return bst->nodes[i].right;
+  }
+
+  bst->nodes[i].left = remove_min(bst, bst->nodes[i].left, min);
+
+  return rebalance(bst, i);
+}
+
+/*
+ * This function removes the first node with the given key found on the way
+ * down from the node at index `i` and returns the index of the new root of the
+ * subtree.  `removed` is set to 1 if a node was removed.
+ */
+static uint32_t remove_key(struct bst_compact* bst, uint32_t i, int key, int* removed) {
+
+  //key isn't in the tree
+  if(i == NIL) {
+    return NIL;
+  }
+
+  struct bst_compact_node* node = &bst->nodes[i];
+
+  if(key < node->key) {
+    node->left = remove_key(bst, node->left, key, removed);
+  }
+
+  else if(key > node->key) {
+    node->right = remove_key(bst, node->right, key, removed);
+  }
+
+  else {
+    uint32_t replacement;
+    *removed = 1;
+
+    //zero or one children: the child (if any) takes the node's place
+    if(node->left == NIL || node->right == NIL) {
+      replacement = (node->left != NIL) ? node->left : node->right;
+      node_release(bst, i);
+      return replacement;
+    }
+
+    //two children: the successor takes the node's place
+    node->right = remove_min(bst, node->right, &replacement);
+    bst->nodes[replacement].left = node->left;
+    bst->nodes[replacement].right = node->right;
+    node_release(bst, i);
+    i = replacement;
+  }
+
+  return rebalance(bst, i);
+}
+
+/*
+ * This function adds up the keys between `lower` and `upper` in the subtree at
+ * index `i`, skipping subtrees that can't contain any of them.
+ */
+static long long range(struct bst_compact* bst, uint32_t i, int lower, int upper) {
+
+  long long sum = 0;
+
+  while(i != NIL) {
+    struct bst_compact_node* node = &bst->nodes[i];
+
+    //everything in range is to the right
+    if(node->key < lower) {
+      i = node->right;
+    }
+
+    //everything in range is to the left
+    else if(node->key > upper) {
+      i = node->left;
+    }
+
+    //the node is in range, so both sides may be too
+    else {
+      sum += node->key + range(bst, node->left, lower, upper);
+      i = node->right;
+    }
+  }
+
+  return sum;
+}
+
+/*
+ * This function should allocate and initialize a new, empty, compact BST and
+ * return a pointer to it.
+ */
+struct bst_compact* bst_compact_create() {
+
+  struct bst_compact* bst = malloc(sizeof(struct bst_compact));
+  bst->capacity = INITIAL_CAPACITY;
+  bst->nodes = malloc(bst->capacity * sizeof(struct bst_compact_node));
+  bst->used = 1;
+  bst->free_list = NIL;
+  bst->root = NIL;
+  bst->size = 0;
+
+  return bst;
+}
+
+/*
+ * This function frees the memory associated with a compact BST.  Since all of
+ * the nodes are in the arena, this is a single free() no matter how big the
+ * tree is.  It does not free the values stored in the BST.
+ *
+ * Params:
+ *   bst - the BST to be destroyed.  May not be NULL.
+ */
+void bst_compact_free(struct bst_compact* bst) {
+  free(bst->nodes);
+  free(bst);
+}
+
+/*
+ * This function returns the number of elements stored in a compact BST.
+ *
+ * Params:
+ *   bst - the BST whose elements are to be counted.  May not be NULL.
+ */
+int bst_compact_size(struct bst_compact* bst) {
+  return bst->size;
+}
+
+/*
+ * This function inserts a new key/value pair into a compact BST, just like
+ * bst_insert().
+ *
+ * Params:
+ *   bst - the BST into which to insert.  May not be NULL.
+ *   key - the key used to order the key/value pair.
+ *   value - the value to store with the key.
+ */
+void bst_compact_insert(struct bst_compact* bst, int key, void* value) {
+
+  //the node is allocated first, since growing the arena moves every node
+  uint32_t leaf = node_alloc(bst);
+  bst->nodes[leaf].key = key;
+  bst->nodes[leaf].value = value;
+  bst->nodes[leaf].left = NIL;
+  bst->nodes[leaf].right = NIL;
+  bst->nodes[leaf].height = 1;
+
+  bst->root = insert(bst, bst->root, leaf);
+  bst->size++;
+}
+
+/*
+ * This function removes the key/value pair with the given key that is closest
+ * to the root, just like bst_remove().  If the key isn't in the BST, nothing
+ * happens.
+ *
+ * Params:
+ *   bst - the BST from which to remove.  May not be NULL.
+ *   key - the key of the key/value pair to remove.
+ */
+void bst_compact_remove(struct bst_compact* bst, int key) {
+  int removed = 0;
+  bst->root = remove_key(bst, bst->root, key, &removed);
+  bst->size -= removed;
+}
+
+/*
+ * This function returns the value stored with a key in a compact BST, just
+ * like bst_get().
+ *
+ * Params:
+ *   bst - the BST to search.  May not be NULL.
+ *   key - the key whose value is to be returned.
+ *
+ * Return:
+ *   Should return the value associated with `key`, or NULL if `key` isn't in
+ *   the BST.
+ */
+void* bst_compact_get(struct bst_compact* bst, int key) {
+
+  uint32_t i = bst->root;
+
+  while(i != NIL) {
+    struct bst_compact_node* node = &bst->nodes[i];
+
+    if(node->key == key) {
+      return node->value;
+    }
+
+    i = (key < node->key) ? node->left : node->right;
+  }
+
+  return NULL;
+}
+
+/*
+ * This function returns the height of a compact BST, which is -1 for an
+ * empty tree, just like bst_height().
+ *
+ * Params:
+ *   bst - the BST whose height is to be returned.  May not be NULL.
+ */
+int bst_compact_height(struct bst_compact* bst) {
+  return height(bst, bst->root) - 1;
+}
+
+/*
+ * This function returns the sum of the keys in a compact BST between a lower
+ * and an upper bound (both inclusive), just like bst_range_sum().
+ *
+ * Params:
+ *   bst - the BST within which to compute a range sum.  May not be NULL.
+ *   lower - the inclusive lower bound of the range.
+ *   upper - the inclusive upper bound of the range.
+ */
+int bst_compact_range_sum(struct bst_compact* bst, int lower, int upper) {
+  return (int)range(bst, bst->root, lower, upper);
+}
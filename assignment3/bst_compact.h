@@ -0,0 +1,29 @@
+/*
+ * This file contains the definition of the interface for a compact binary
+ * search tree, which stores all of its nodes in one contiguous array.  You can
+ * find descriptions of the compact BST functions, including their parameters
+ * and their return values, in bst_compact.c.
+ */
+
+#ifndef __BST_COMPACT_H
+#define __BST_COMPACT_H
+
+/*
+ * Structure used to represent a compact binary search tree.
+ */
+struct bst_compact;
+
+/*
+ * Compact binary search tree interface function prototypes.  Refer to
+ * bst_compact.c for documentation about each of these functions.
+ */
+struct bst_compact* bst_compact_create();
+void bst_compact_free(struct bst_compact* bst);
+int bst_compact_size(struct bst_compact* bst);
+void bst_compact_insert(struct bst_compact* bst, int key, void* value);
+void bst_compact_remove(struct bst_compact* bst, int key);
+void* bst_compact_get(struct bst_compact* bst, int key);
+int bst_compact_height(struct bst_compact* bst);
+int bst_compact_range_sum(struct bst_compact* bst, int lower, int upper);
+
+#endif
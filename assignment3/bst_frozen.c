@@ -0,0 +1,493 @@
+/*
+ * This file contains the implementation of a frozen binary search tree: a
+ * read-only copy of a BST that is much faster to search.
+ *
+ * Instead of nodes and pointers, the keys are stored in one flat array in
+ * "Eytzinger" (breadth-first) order, the same layout a binary heap uses: the
+ * root is at index 1, and the children of index k are at 2k and 2k + 1.  A
+ * search is then just a loop that moves from k to 2k or 2k + 1, which needs
+ * no pointers, can be written without a branch on the comparison, and lets
+ * us prefetch the cache line holding the node's descendants four levels down
+ * (16 ints fill one 64-byte cache line) while the current level is compared.
+ * The values are kept in a second array in the same order.
+ *
+ * A frozen BST can also be saved to a file in this same layout, so loading it
+ * back means mapping the file into memory and using its key array in place.
+ * The file holds a 64-byte header, the key array (in native byte order, with
+ * index 0 unused so keys[16m] still starts a cache line), the bytes of each
+ * value one after another in Eytzinger order, and then an array of offsets
+ * where value k's bytes run from offsets[k] to offsets[k + 1].
+ *
+ * Name: Gabriel de Leon
+ * Email: deleong@oregonstate.edu
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "bst_frozen.h"
+
+/*
+ * This is the size of a cache line in bytes, which the key array is aligned
+ * to so that each group of 16 keys fills exactly one line.
+ */
+#define CACHE_LINE 64
+
+/*
+ * This asks the CPU to start loading memory into cache before it's needed.
+ * It is only a hint, so it's left out for compilers without the builtin.
+ */
+#if defined(__GNUC__)
+#define PREFETCH(ptr) __builtin_prefetch(ptr)
+#else
+#define PREFETCH(ptr)
+#endif
+
+/*
+ * This is the magic string every saved frozen BST file starts with.
+ */
+#define FILE_MAGIC "BSTFRZ01"
+
+/*
+ * This structure represents a frozen BST.  keys[1] through keys[n] hold the
+ * keys in Eytzinger order and values[k] is the value for keys[k]; index 0 of
+ * both arrays is unused.  `block` is the allocation `keys` points into, which
+ * is what gets freed.
+ *
+ * A frozen BST mapped from a file has no `values` array.  Instead, the value
+ * for keys[k] is a pointer to its bytes, data + offsets[k], and `block` is the
+ * mapping of `mapped_size` bytes.
+ */
+struct bst_frozen {
+  int* keys;
+  void** values;
+  int n;
+  void* block;
+  long long* offsets;
+  char* data;
+  size_t mapped_size;
+};
+
+/*
+ * This structure represents the header at the start of a saved frozen BST.
+ * The key array starts right after it, and `data_pos` and `offsets_pos` are
+ * the file positions of the value bytes and the offset array.
+ */
+struct file_header {
+  char magic[8];
+  long long n;
+  long long data_pos;
+  long long offsets_pos;
+  char unused[32];
+};
+
+/*
+ * This structure represents an in-order iterator over a frozen BST.  `k` is
+ * the index of the next key to return, or 0 once every key has been returned.
+ */
+struct bst_frozen_iterator {
+  struct bst_frozen* frozen;
+  int k;
+};
+
+/*
+ * This function returns the index of the node that comes first in order in
+ * the subtree rooted at index `k`, i.e. the end of its chain of left children.
+ */
+static int leftmost(int n, int k) {
+  while(2 * k <= n) {
+    k = 2 * k;
+  }
+  return k;
+}
+
+/*
+ * This function returns the index of the node that comes after index `k` in
+ * order, or 0 if `k` is the last node.
+ */
+static int successor(int n, int k) {
+
+  //the next node is the first one in the right subtree
+  if(2 * k + 1 <= n) {
+    return leftmost(n, 2 * k + 1);
+  }
+
+  //otherwise it's the first ancestor we reach from its left subtree
+  while(k & 1) {
+    k >>= 1;
+  }
+  return k >> 1;
+}
+
+/*
+ * This function returns the value for keys[k].
+ */
+static void* value_at(struct bst_frozen* frozen, int k) {
+  if(frozen->values != NULL) {
+    return frozen->values[k];
+  }
+  return frozen->data + frozen->offsets[k];
+}
+
+/*
+ * This function returns a snapshot of a BST laid out in Eytzinger order.  The
+ * snapshot doesn't change if the BST is changed or freed afterwards, but the
+ * values are shared with the BST (they aren't copied).  Takes O(n) time.
+ *
+ * Params:
+ *   bst - the BST to be frozen.  May not be NULL.
+ *
+ * Return:
+ *   Should return a new frozen BST with the same keys and values as `bst`.
+ */
+struct bst_frozen* bst_freeze(struct bst* bst) {
+
+  struct bst_frozen* frozen = malloc(sizeof(struct bst_frozen));
+  int n = bst_size(bst);
+  frozen->n = n;
+
+  //the key array is aligned by hand so that keys[16m] starts a cache line
+  frozen->block = malloc((n + 1) * sizeof(int) + CACHE_LINE);
+  uintptr_t aligned = ((uintptr_t)frozen->block + CACHE_LINE - 1) & ~(uintptr_t)(CACHE_LINE - 1);
+  frozen->keys = (int*)aligned;
+  frozen->values = malloc((n + 1) * sizeof(void*));
+  frozen->offsets = NULL;
+  frozen->data = NULL;
+  frozen->mapped_size = 0;
+
+  //the BST's in-order walk fills the slots in the Eytzinger tree's in-order order
+  struct bst_iterator* iter = bst_iterator_create(bst);
+  for(int k = leftmost(n, 1); k != 0 && bst_iterator_has_next(iter); k = successor(n, k)) {
+    frozen->keys[k] = bst_iterator_next(iter, &frozen->values[k]);
+  }
+  bst_iterator_free(iter);
+
+  return frozen;
+}
+
+/*
+ * This function frees the memory associated with a frozen BST.  It does not
+ * free the values stored in it.
+ *
+ * Params:
+ *   frozen - the frozen BST to be destroyed.  May not be NULL.
+ */
+void bst_frozen_free(struct bst_frozen* frozen) {
+  if(frozen->values == NULL) {
+    munmap(frozen->block, frozen->mapped_size);
+  }
+  else {
+    free(frozen->block);
+    free(frozen->values);
+  }
+  free(frozen);
+}
+
+/*
+ * This function returns the number of keys in a frozen BST.
+ *
+ * Params:
+ *   frozen - the frozen BST whose keys are to be counted.  May not be NULL.
+ */
+int bst_frozen_size(struct bst_frozen* frozen) {
+  return frozen->n;
+}
+
+/*
+ * This function returns the value associated with a key in a frozen BST.  If
+ * the key was stored more than once, the value of the first one in sorted
+ * order is returned.
+ *
+ * Params:
+ *   frozen - the frozen BST to search.  May not be NULL.
+ *   key - the key whose value is to be returned.
+ *
+ * Return:
+ *   Should return the value associated with `key`, or NULL if `key` isn't in
+ *   the frozen BST.
+ */
+void* bst_frozen_get(struct bst_frozen* frozen, int key) {
+
+  int* keys = frozen->keys;
+  int n = frozen->n;
+  int k = 1;
+
+  //walks down to a leaf, going right whenever the node's key is too small
+  while(k <= n) {
+    PREFETCH(keys + 16 * k);
+    k = 2 * k + (keys[k] < key);
+  }
+
+  //the last left turn we took was at the first key >= `key`; undoing the
+  //right turns after it (the trailing 1 bits) and that left turn leads there
+  while(k & 1) {
+    k >>= 1;
+  }
+  k >>= 1;
+
+  if(k == 0 || keys[k] != key) {
+    return NULL;
+  }
+
+  return value_at(frozen, k);
+}
+
+/*
+ * This function allocates an in-order iterator over a frozen BST.  Stepping
+ * the iterator never allocates memory.
+ *
+ * Params:
+ *   frozen - the frozen BST over which to iterate.  May not be NULL.
+ */
+struct bst_frozen_iterator* bst_frozen_iterator_create(struct bst_frozen* frozen) {
+
+  struct bst_frozen_iterator* iter = malloc(sizeof(struct bst_frozen_iterator));
+  iter->frozen = frozen;
+  iter->k = (frozen->n > 0) ? leftmost(frozen->n, 1) : 0;
+
+  return iter;
+}
+
+/*
+ * This function frees the memory associated with a frozen BST iterator.
+ *
+ * Params:
+ *   iter - the iterator to be destroyed.  May not be NULL.
+ */
+void bst_frozen_iterator_free(struct bst_frozen_iterator* iter) {
+  free(iter);
+}
+
+/*
+ * This function returns 1 if a frozen BST iterator has more keys to return,
+ * or 0 otherwise.
+ *
+ * Params:
+ *   iter - the iterator to be checked.  May not be NULL.
+ */
+int bst_frozen_iterator_has_next(struct bst_frozen_iterator* iter) {
+  return iter->k != 0;
+}
+
+/*
+ * This function returns the next key from a frozen BST iterator and stores
+ * its value at `value` (if `value` isn't NULL).  It may only be called if
+ * bst_frozen_iterator_has_next() returns 1.
+ *
+ * Params:
+ *   iter - the iterator.  May not be NULL.
+ *   value - pointer at which the key's value should be stored.
+ *
+ * Return:
+ *   Should return the next key in sorted order.
+ */
+int bst_frozen_iterator_next(struct bst_frozen_iterator* iter, void** value) {
+
+  int k = iter->k;
+
+  if(value != NULL) {
+    *value = value_at(iter->frozen, k);
+  }
+  iter->k = successor(iter->frozen->n, k);
+
+  return iter->frozen->keys[k];
+}
+
+/*
+ * This function writes a BST to a file in the frozen layout described at the
+ * top of this file.  Each value is written by calling `value_writer`, which
+ * may write any number of bytes (including none) to the file.  Takes O(n)
+ * time.
+ *
+ * Params:
+ *   bst - the BST to be saved.  May not be NULL.
+ *   path - the path of the file to write.  Any existing file is replaced.
+ *   value_writer - function that writes the bytes of one value to `file`.
+ *     May be NULL, in which case no value bytes are written.
+ *
+ * Return:
+ *   Should return 0 on success, or -1 if the file couldn't be written.
+ */
+int bst_save(struct bst* bst, const char* path, void (*value_writer)(void* value, FILE* file)) {
+
+  FILE* file = fopen(path, "wb");
+  if(file == NULL) {
+    return -1;
+  }
+
+  struct bst_frozen* frozen = bst_freeze(bst);
+  int n = frozen->n;
+  long long* offsets = malloc((n + 2) * sizeof(long long));
+
+  struct file_header header;
+  memset(&header, 0, sizeof(struct file_header));
+  memcpy(header.magic, FILE_MAGIC, sizeof(header.magic));
+  header.n = n;
+  header.data_pos = sizeof(struct file_header) + (n + 1) * sizeof(int);
+
+  //the header is written again at the end, once the offsets' position is known
+  fwrite(&header, sizeof(struct file_header), 1, file);
+  frozen->keys[0] = 0;
+  fwrite(frozen->keys, sizeof(int), n + 1, file);
+
+  offsets[0] = 0;
+  for(int k = 1; k <= n; k++) {
+    offsets[k] = ftell(file) - header.data_pos;
+    if(value_writer != NULL) {
+      value_writer(frozen->values[k], file);
+    }
+  }
+  offsets[n + 1] = ftell(file) - header.data_pos;
+
+  //pads the value bytes so the offset array is 8-byte aligned
+  header.offsets_pos = (ftell(file) + 7) & ~7LL;
+  while(ftell(file) < header.offsets_pos) {
+    fputc(0, file);
+  }
+  fwrite(offsets, sizeof(long long), n + 2, file);
+
+  fseek(file, 0, SEEK_SET);
+  fwrite(&header, sizeof(struct file_header), 1, file);
+
+  free(offsets);
+  bst_frozen_free(frozen);
+
+  //a failed write anywhere above shows up as an error on the stream or on close
+  int failed = ferror(file);
+  if(fclose(file) != 0 || failed) {
+    return -1;
+  }
+
+  return 0;
+}
+
+/*
+ * This function maps a file written by bst_save() into memory read-only and
+ * returns a frozen BST that uses it in place.  Nothing is copied and no work
+ * is done per key; the pages are read in by the operating system as lookups
+ * touch them.  The only pass over the file is a check of the offset array,
+ * so a corrupt or truncated file can't give out value pointers that lead
+ * outside the mapping.
+ *
+ * The value for each key is a pointer to the bytes `value_writer` wrote for
+ * it, inside the mapping.  These bytes must not be changed, and they go away
+ * when the frozen BST is freed.
+ *
+ * Params:
+ *   path - the path of the file to map.
+ *
+ * Return:
+ *   Should return a new frozen BST, or NULL if the file couldn't be mapped or
+ *   isn't a valid saved BST.
+ */
+struct bst_frozen* bst_map(const char* path) {
+
+  int fd = open(path, O_RDONLY);
+  if(fd < 0) {
+    return NULL;
+  }
+
+  struct stat st;
+  if(fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(struct file_header)) {
+    close(fd);
+    return NULL;
+  }
+
+  //the mapping stays valid after the file is closed
+  size_t size = st.st_size;
+  char* base = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if(base == MAP_FAILED) {
+    return NULL;
+  }
+
+  //checks that the arrays the header describes actually fit in the file
+  struct file_header* header = (struct file_header*)base;
+  long long n = header->n;
+  if(memcmp(header->magic, FILE_MAGIC, sizeof(header->magic)) != 0
+      || n < 0 || n >= INT32_MAX
+      || header->data_pos != (long long)(sizeof(struct file_header) + (n + 1) * sizeof(int))
+      || header->offsets_pos < header->data_pos || (header->offsets_pos & 7)
+      || header->offsets_pos + (n + 2) * (long long)sizeof(long long) > (long long)size) {
+    munmap(base, size);
+    return NULL;
+  }
+
+  //checks that every value's bytes lie between the key array and the offsets
+  long long* offsets = (long long*)(base + header->offsets_pos);
+  if(offsets[0] != 0 || offsets[n + 1] > header->offsets_pos - header->data_pos) {
+    munmap(base, size);
+    return NULL;
+  }
+  for(long long k = 0; k <= n; k++) {
+    if(offsets[k] > offsets[k + 1]) {
+      munmap(base, size);
+      return NULL;
+    }
+  }
+
+  struct bst_frozen* frozen = malloc(sizeof(struct bst_frozen));
+  frozen->n = n;
+  frozen->keys = (int*)(base + sizeof(struct file_header));
+  frozen->values = NULL;
+  frozen->offsets = offsets;
+  frozen->data = base + header->data_pos;
+  frozen->block = base;
+  frozen->mapped_size = size;
+
+  return frozen;
+}
+
+/*
+ * This function reads a file written by bst_save() and builds an ordinary
+ * BST from it in O(n) time, without doing any comparisons.  Each value is
+ * made by calling `value_reader` on the bytes `value_writer` wrote for it.
+ *
+ * Params:
+ *   path - the path of the file to read.
+ *   value_reader - function that makes a value from `size` bytes at `data`.
+ *     The bytes are only valid during the call.  May be NULL, in which case
+ *     every value is NULL.
+ *
+ * Return:
+ *   Should return a new BST, or NULL if the file couldn't be read or isn't a
+ *   valid saved BST.
+ */
+struct bst* bst_load(const char* path, void* (*value_reader)(void* data, size_t size)) {
+
+  struct bst_frozen* frozen = bst_map(path);
+  if(frozen == NULL) {
+    return NULL;
+  }
+
+  int n = frozen->n;
+  int* keys = malloc((n + 1) * sizeof(int));
+  void** values = malloc((n + 1) * sizeof(void*));
+
+  //walks the frozen tree in order to get the keys back in sorted order
+  int i = 0;
+  for(int k = (n > 0) ? leftmost(n, 1) : 0; k != 0; k = successor(n, k)) {
+    keys[i] = frozen->keys[k];
+    values[i] = NULL;
+    if(value_reader != NULL) {
+      values[i] = value_reader(frozen->data + frozen->offsets[k], frozen->offsets[k + 1] - frozen->offsets[k]);
+    }
+    i++;
+  }
+
+  struct bst* bst = bst_create_from_sorted(keys, values, n);
+
+  free(keys);
+  free(values);
+  bst_frozen_free(frozen);
+
+  return bst;
+}
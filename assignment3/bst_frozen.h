@@ -0,0 +1,47 @@
+/*
+ * This file contains the definition of the interface for a frozen binary
+ * search tree, which is a read-only snapshot of a BST laid out for fast
+ * lookups.  You can find descriptions of the frozen BST functions, including
+ * their parameters and their return values, in bst_frozen.c.
+ */
+
+#ifndef __BST_FROZEN_H
+#define __BST_FROZEN_H
+
+#include <stdio.h>
+
+#include "bst.h"
+
+/*
+ * Structure used to represent a frozen binary search tree.
+ */
+struct bst_frozen;
+
+/*
+ * Frozen binary search tree interface function prototypes.  Refer to
+ * bst_frozen.c for documentation about each of these functions.
+ */
+struct bst_frozen* bst_freeze(struct bst* bst);
+void bst_frozen_free(struct bst_frozen* frozen);
+int bst_frozen_size(struct bst_frozen* frozen);
+void* bst_frozen_get(struct bst_frozen* frozen, int key);
+
+int bst_save(struct bst* bst, const char* path, void (*value_writer)(void* value, FILE* file));
+struct bst_frozen* bst_map(const char* path);
+struct bst* bst_load(const char* path, void* (*value_reader)(void* data, size_t size));
+
+/*
+ * Structure used to represent a frozen binary search tree iterator.
+ */
+struct bst_frozen_iterator;
+
+/*
+ * Frozen binary search tree iterator interface prototypes.  Refer to
+ * bst_frozen.c for documentation about each of these functions.
+ */
+struct bst_frozen_iterator* bst_frozen_iterator_create(struct bst_frozen* frozen);
+void bst_frozen_iterator_free(struct bst_frozen_iterator* iter);
+int bst_frozen_iterator_has_next(struct bst_frozen_iterator* iter);
+int bst_frozen_iterator_next(struct bst_frozen_iterator* iter, void** value);
+
+#endif
@@ -0,0 +1,655 @@
+/*
+ * This file contains the implementation of a B+ tree.  It offers the same
+ * operations as the BST in bst.c, but each node holds up to BTREE_MAX_KEYS
+ * keys instead of one, so a lookup touches far fewer nodes (and cache lines)
+ * on its way down.  All key/value pairs live in the leaves; the keys in the
+ * inner nodes only guide searches.  The leaves are linked together in key
+ * order, so iteration and range sums just walk along the leaves.
+ *
+ * Every node starts with its key count and keys, which together take exactly
+ * one 64-byte cache line.  Nodes are allocated on 64-byte boundaries so that
+ * block really is a single line, and choosing which child to visit only
+ * reads one line per level.
+ *
+ * Like the BST, the tree may hold the same key more than once.  For keys in an
+ * inner node, every key in child i is <= keys[i] and every key in child i + 1
+ * is >= keys[i], so copies of a key can be spread over neighbouring leaves.
+ * Inserts go after any equal keys, and lookups and removals find the first
+ * copy in key order.
+ *
+ * Name: Gabriel de Leon
+ * Email: deleong@oregonstate.edu
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <limits.h>
+
+#include "btree.h"
+
+/*
+ * This is the largest number of keys a node can hold.  Each node's key array
+ * has room for one more, which is used for a moment when a node overflows
+ * before it is split.  Nodes other than the root hold at least BTREE_MIN_KEYS.
+ */
+#define BTREE_MAX_KEYS 14
+#define BTREE_MIN_KEYS (BTREE_MAX_KEYS / 2)
+
+/*
+ * This is the size of a cache line, which every node is aligned to.
+ */
+#define CACHE_LINE_SIZE 64
+
+/*
+ * This structure represents the part shared by leaves and inner nodes: the
+ * number of keys and the keys themselves.
+ */
+struct btree_node {
+  short leaf;
+  short n;
+  int keys[BTREE_MAX_KEYS + 1];
+};
+
+/*
+ * These check at compile time that the key block fills exactly one cache
+ * line and that the keys end at the end of it.  Each array gets a size of -1,
+ * which won't compile, if its check fails.  Leaves and inner nodes start with
+ * this block and are allocated on cache line boundaries by node_alloc(), so
+ * the block is always one aligned line.
+ */
+typedef char btree_node_fills_line[sizeof(struct btree_node) == CACHE_LINE_SIZE ? 1 : -1];
+typedef char btree_keys_end_line[offsetof(struct btree_node, keys) + (BTREE_MAX_KEYS + 1) * sizeof(int) == CACHE_LINE_SIZE ? 1 : -1];
+
+/*
+ * This structure represents a leaf.  values[i] is the value stored with
+ * keys[i], and `next` is the leaf with the next larger keys.
+ */
+struct btree_leaf {
+  struct btree_node node;
+  void* values[BTREE_MAX_KEYS + 1];
+  struct btree_leaf* next;
+};
+
+/*
+ * This structure represents an inner node, which has one more child than it
+ * has keys.
+ */
+struct btree_inner {
+  struct btree_node node;
+  struct btree_node* children[BTREE_MAX_KEYS + 2];
+};
+
+/*
+ * This structure represents an entire B+ tree.
+ */
+struct btree {
+  struct btree_node* root;
+  int size;
+};
+
+/*
+ * This structure represents an iterator over a B+ tree.  `leaf` and `index`
+ * locate the next key to return, and `upper` is the largest key to return.
+ */
+struct btree_iterator {
+  struct btree_leaf* leaf;
+  int index;
+  int upper;
+};
+
+/*
+ * These functions view a node as a leaf or as an inner node.
+ */
+static struct btree_leaf* as_leaf(struct btree_node* node) {
+  return (struct btree_leaf*)node;
+}
+
+static struct btree_inner* as_inner(struct btree_node* node) {
+  return (struct btree_inner*)node;
+}
+
+/*
+ * This function allocates `size` bytes starting on a cache line boundary, so
+ * a node's key block doesn't straddle two lines.  malloc() only promises
+ * 16-byte alignment.
+ */
+static void* node_alloc(size_t size) {
+  void* node;
+  if(posix_memalign(&node, CACHE_LINE_SIZE, size) != 0) {
+    return NULL;
+  }
+  return node;
+}
+
+/*
+ * These functions allocate a new, empty leaf or inner node.
+ */
+static struct btree_leaf* leaf_create() {
+  struct btree_leaf* leaf = node_alloc(sizeof(struct btree_leaf));
+  leaf->node.leaf = 1;
+  leaf->node.n = 0;
+  leaf->next = NULL;
+  return leaf;
+}
+
+static struct btree_inner* inner_create() {
+  struct btree_inner* inner = node_alloc(sizeof(struct btree_inner));
+  inner->node.leaf = 0;
+  inner->node.n = 0;
+  return inner;
+}
+
+/*
+ * This function returns the number of keys in a node that are less than
+ * `key` (if `upper` is 0) or less than or equal to `key` (if `upper` is 1).
+ * For an inner node this is the index of the child to visit.
+ */
+static int search(struct btree_node* node, int key, int upper) {
+  int i = 0;
+  while(i < node->n && (node->keys[i] < key || (upper && node->keys[i] == key))) {
+    i++;
+  }
+  return i;
+}
+
+/*
+ * This function finds the position of the first key >= `key` in the leaves,
+ * storing the leaf in `leaf` and the index in `index`.  If every key is
+ * smaller, `leaf` is set to NULL.
+ */
+static void lower_bound(struct btree* btree, int key, struct btree_leaf** leaf, int* index) {
+
+  struct btree_node* node = btree->root;
+  while(!node->leaf) {
+    node = as_inner(node)->children[search(node, key, 0)];
+  }
+
+  *leaf = as_leaf(node);
+  *index = search(node, key, 0);
+
+  //copies of a key can start at the front of the next leaf
+  if(*index == node->n) {
+    *leaf = (*leaf)->next;
+    *index = 0;
+  }
+}
+
+/*
+ * This function frees a node and all of its descendants.
+ */
+static void node_free(struct btree_node* node) {
+  if(!node->leaf) {
+    for(int i = 0; i <= node->n; i++) {
+      node_free(as_inner(node)->children[i]);
+    }
+  }
+  free(node);
+}
+
+/*
+ * This function splits a node that has overflowed to BTREE_MAX_KEYS + 1 keys.
+ * The upper part moves to a new node, which is returned, and `separator` is
+ * set to the key that goes up to the parent between the two halves.
+ */
+static struct btree_node* split(struct btree_node* node, int* separator) {
+
+  //a leaf keeps its lower half and the new leaf starts with the separator
+  if(node->leaf) {
+    struct btree_leaf* left = as_leaf(node);
+    struct btree_leaf* right = leaf_create();
+    int keep = (node->n + 1) / 2;
+
+    for(int i = keep; i < node->n; i++) {
+      right->node.keys[i - keep] = node->keys[i];
+      right->values[i - keep] = left->values[i];
+    }
+    right->node.n = node->n - keep;
+    node->n = keep;
+
+    right->next = left->next;
+    left->next = right;
+
+    *separator = right->node.keys[0];
+    return &right->node;
+  }
+
+  //an inner node's middle key moves up and isn't kept in either half
+  struct btree_inner* left = as_inner(node);
+  struct btree_inner* right = inner_create();
+  int keep = node->n / 2;
+
+  *separator = node->keys[keep];
+  for(int i = keep + 1; i < node->n; i++) {
+    right->node.keys[i - keep - 1] = node->keys[i];
+  }
+  for(int i = keep + 1; i <= node->n; i++) {
+    right->children[i - keep - 1] = left->children[i];
+  }
+  right->node.n = node->n - keep - 1;
+  node->n = keep;
+
+  return &right->node;
+}
+
+/*
+ * This function inserts a key/value pair into the subtree rooted at `node`.
+ * If `node` has to be split, the new right half is returned and `separator`
+ * is set to the key between the halves; otherwise NULL is returned.
+ */
+static struct btree_node* insert(struct btree_node* node, int key, void* value, int* separator) {
+
+  if(node->leaf) {
+    struct btree_leaf* leaf = as_leaf(node);
+    int pos = search(node, key, 1);
+
+    //shifts larger keys over to make room
+    for(int i = node->n; i > pos; i--) {
+      node->keys[i] = node->keys[i - 1];
+      leaf->values[i] = leaf->values[i - 1];
+    }
+    node->keys[pos] = key;
+    leaf->values[pos] = value;
+    node->n++;
+  }
+
+  else {
+    struct btree_inner* inner = as_inner(node);
+    int pos = search(node, key, 1);
+    int child_separator;
+
+    struct btree_node* sibling = insert(inner->children[pos], key, value, &child_separator);
+    if(sibling == NULL) {
+      return NULL;
+    }
+
+    //the child split, so its new sibling goes in right after it
+    for(int i = node->n; i > pos; i--) {
+      node->keys[i] = node->keys[i - 1];
+      inner->children[i + 1] = inner->children[i];
+    }
+    node->keys[pos] = child_separator;
+    inner->children[pos + 1] = sibling;
+    node->n++;
+  }
+
+  if(node->n > BTREE_MAX_KEYS) {
+    return split(node, separator);
+  }
+
+  return NULL;
+}
+
+/*
+ * This function fixes child `i` of an inner node after a removal left it with
+ * fewer than BTREE_MIN_KEYS keys, by borrowing a key from a sibling that can
+ * spare one or else merging it with a sibling.
+ */
+static void fix_child(struct btree_inner* parent, int i) {
+
+  struct btree_node* child = parent->children[i];
+  struct btree_node* left = (i > 0) ? parent->children[i - 1] : NULL;
+  struct btree_node* right = (i < parent->node.n) ? parent->children[i + 1] : NULL;
+
+  //borrows the last key of the left sibling
+  if(left != NULL && left->n > BTREE_MIN_KEYS) {
+    for(int j = child->n; j > 0; j--) {
+      child->keys[j] = child->keys[j - 1];
+    }
+
+    if(child->leaf) {
+      for(int j = child->n; j > 0; j--) {
+        as_leaf(child)->values[j] = as_leaf(child)->values[j - 1];
+      }
+      child->keys[0] = left->keys[left->n - 1];
+      as_leaf(child)->values[0] = as_leaf(left)->values[left->n - 1];
+      parent->node.keys[i - 1] = child->keys[0];
+    }
+    else {
+      for(int j = child->n + 1; j > 0; j--) {
+        as_inner(child)->children[j] = as_inner(child)->children[j - 1];
+      }
+      child->keys[0] = parent->node.keys[i - 1];
+      as_inner(child)->children[0] = as_inner(left)->children[left->n];
+      parent->node.keys[i - 1] = left->keys[left->n - 1];
+    }
+
+    child->n++;
+    left->n--;
+    return;
+  }
+
+  //borrows the first key of the right sibling
+  if(right != NULL && right->n > BTREE_MIN_KEYS) {
+    if(child->leaf) {
+      child->keys[child->n] = right->keys[0];
+      as_leaf(child)->values[child->n] = as_leaf(right)->values[0];
+      for(int j = 0; j < right->n - 1; j++) {
+        right->keys[j] = right->keys[j + 1];
+        as_leaf(right)->values[j] = as_leaf(right)->values[j + 1];
+      }
+      parent->node.keys[i] = right->keys[0];
+    }
+    else {
+      child->keys[child->n] = parent->node.keys[i];
+      as_inner(child)->children[child->n + 1] = as_inner(right)->children[0];
+      parent->node.keys[i] = right->keys[0];
+      for(int j = 0; j < right->n - 1; j++) {
+        right->keys[j] = right->keys[j + 1];
+      }
+      for(int j = 0; j < right->n; j++) {
+        as_inner(right)->children[j] = as_inner(right)->children[j + 1];
+      }
+    }
+
+    child->n++;
+    right->n--;
+    return;
+  }
+
+  //neither sibling can spare a key, so two siblings are merged into one
+  if(left == NULL) {
+    left = child;
+    i++;
+  }
+  child = parent->children[i];
+
+  //`child` is appended to `left`, with the separator between them if inner
+  if(left->leaf) {
+    for(int j = 0; j < child->n; j++) {
+      left->keys[left->n + j] = child->keys[j];
+      as_leaf(left)->values[left->n + j] = as_leaf(child)->values[j];
+    }
+    left->n += child->n;
+    as_leaf(left)->next = as_leaf(child)->next;
+  }
+  else {
+    left->keys[left->n] = parent->node.keys[i - 1];
+    for(int j = 0; j < child->n; j++) {
+      left->keys[left->n + 1 + j] = child->keys[j];
+    }
+    for(int j = 0; j <= child->n; j++) {
+      as_inner(left)->children[left->n + 1 + j] = as_inner(child)->children[j];
+    }
+    left->n += child->n + 1;
+  }
+  free(child);
+
+  //removes the separator and the merged child from the parent
+  for(int j = i - 1; j < parent->node.n - 1; j++) {
+    parent->node.keys[j] = parent->node.keys[j + 1];
+  }
+  for(int j = i; j < parent->node.n; j++) {
+    parent->children[j] = parent->children[j + 1];
+  }
+  parent->node.n--;
+}
+
+/*
+ * This function removes the first copy of `key` in key order from the subtree
+ * rooted at `node`, leaving any child it passes through with at least
+ * BTREE_MIN_KEYS keys.  Returns 1 if a key was removed and 0 otherwise.
+ */
+static int remove_key(struct btree_node* node, int key) {
+
+  if(node->leaf) {
+    struct btree_leaf* leaf = as_leaf(node);
+    int pos = search(node, key, 0);
+
+    if(pos == node->n || node->keys[pos] != key) {
+      return 0;
+    }
+
+    for(int i = pos; i < node->n - 1; i++) {
+      node->keys[i] = node->keys[i + 1];
+      leaf->values[i] = leaf->values[i + 1];
+    }
+    node->n--;
+
+    return 1;
+  }
+
+  struct btree_inner* inner = as_inner(node);
+
+  //copies of the key may continue into the next child when a separator equals it
+  for(int i = search(node, key, 0); i <= node->n; i++) {
+
+    if(remove_key(inner->children[i], key)) {
+      if(inner->children[i]->n < BTREE_MIN_KEYS) {
+        fix_child(inner, i);
+      }
+      return 1;
+    }
+
+    if(i == node->n || node->keys[i] != key) {
+      break;
+    }
+  }
+
+  return 0;
+}
+
+/*
+ * This function should allocate and initialize a new, empty B+ tree and
+ * return a pointer to it.  The root starts out as an empty leaf.
+ */
+struct btree* btree_create() {
+
+  struct btree* btree = malloc(sizeof(struct btree));
+  btree->root = &leaf_create()->node;
+  btree->size = 0;
+
+  return btree;
+}
+
+/*
+ * This function frees the memory associated with a B+ tree.  It does not free
+ * the values stored in the tree.
+ *
+ * Params:
+ *   btree - the B+ tree to be destroyed.  May not be NULL.
+ */
+void btree_free(struct btree* btree) {
+  node_free(btree->root);
+  free(btree);
+}
+
+/*
+ * This function returns the number of key/value pairs stored in a B+ tree.
+ *
+ * Params:
+ *   btree - the B+ tree whose elements are to be counted.  May not be NULL.
+ */
+int btree_size(struct btree* btree) {
+  return btree->size;
+}
+
+/*
+ * This function inserts a new key/value pair into a B+ tree, after any pairs
+ * with an equal key.  Takes O(log n) time.
+ *
+ * Params:
+ *   btree - the B+ tree into which to insert.  May not be NULL.
+ *   key - the key used to order the key/value pair.
+ *   value - the value to store with the key.
+ */
+void btree_insert(struct btree* btree, int key, void* value) {
+
+  int separator;
+  struct btree_node* sibling = insert(btree->root, key, value, &separator);
+
+  //the root split, so a new root is added above the two halves
+  if(sibling != NULL) {
+    struct btree_inner* root = inner_create();
+    root->node.keys[0] = separator;
+    root->node.n = 1;
+    root->children[0] = btree->root;
+    root->children[1] = sibling;
+    btree->root = &root->node;
+  }
+
+  btree->size++;
+}
+
+/*
+ * This function removes the first key/value pair with a given key (in key
+ * order) from a B+ tree.  If the key isn't in the tree, nothing happens.
+ * Takes O(log n) time.
+ *
+ * Params:
+ *   btree - the B+ tree from which to remove.  May not be NULL.
+ *   key - the key of the key/value pair to remove.
+ */
+void btree_remove(struct btree* btree, int key) {
+
+  if(!remove_key(btree->root, key)) {
+    return;
+  }
+  btree->size--;
+
+  //an inner root left with a single child is replaced by that child
+  struct btree_node* root = btree->root;
+  if(!root->leaf && root->n == 0) {
+    btree->root = as_inner(root)->children[0];
+    free(root);
+  }
+}
+
+/*
+ * This function returns the value stored with the first copy of a key in a
+ * B+ tree.  Takes O(log n) time.
+ *
+ * Params:
+ *   btree - the B+ tree to search.  May not be NULL.
+ *   key - the key whose value is to be returned.
+ *
+ * Return:
+ *   Should return the value associated with `key`, or NULL if `key` isn't in
+ *   the tree.
+ */
+void* btree_get(struct btree* btree, int key) {
+
+  struct btree_leaf* leaf;
+  int index;
+  lower_bound(btree, key, &leaf, &index);
+
+  if(leaf == NULL || leaf->node.keys[index] != key) {
+    return NULL;
+  }
+
+  return leaf->values[index];
+}
+
+/*
+ * This function returns the sum of the keys in a B+ tree between a lower and
+ * an upper bound (both inclusive).  It finds the first key in range and then
+ * walks along the leaves, so it takes O(log n + k) time for k keys in range,
+ * reading the keys a whole leaf at a time.
+ *
+ * Params:
+ *   btree - the B+ tree within which to compute a range sum.  May not be NULL.
+ *   lower - the inclusive lower bound of the range.
+ *   upper - the inclusive upper bound of the range.
+ */
+int btree_range_sum(struct btree* btree, int lower, int upper) {
+
+  struct btree_leaf* leaf;
+  int index;
+  long long sum = 0;
+  lower_bound(btree, lower, &leaf, &index);
+
+  while(leaf != NULL) {
+    for(; index < leaf->node.n; index++) {
+      if(leaf->node.keys[index] > upper) {
+        return (int)sum;
+      }
+      sum += leaf->node.keys[index];
+    }
+    leaf = leaf->next;
+    index = 0;
+  }
+
+  return (int)sum;
+}
+
+/*
+ * This function allocates an iterator that returns the key/value pairs of a
+ * B+ tree between `lower` and `upper` (both inclusive) in key order.  It
+ * starts at the first key >= `lower` in O(log n) time.
+ *
+ * Params:
+ *   btree - the B+ tree over which to iterate.  May not be NULL.
+ *   lower - the inclusive lower bound of the keys to return.
+ *   upper - the inclusive upper bound of the keys to return.
+ */
+struct btree_iterator* btree_iterator_create_range(struct btree* btree, int lower, int upper) {
+
+  struct btree_iterator* iter = malloc(sizeof(struct btree_iterator));
+  lower_bound(btree, lower, &iter->leaf, &iter->index);
+  iter->upper = upper;
+
+  return iter;
+}
+
+/*
+ * This function allocates an iterator that returns every key/value pair of a
+ * B+ tree in key order.
+ *
+ * Params:
+ *   btree - the B+ tree over which to iterate.  May not be NULL.
+ */
+struct btree_iterator* btree_iterator_create(struct btree* btree) {
+  return btree_iterator_create_range(btree, INT_MIN, INT_MAX);
+}
+
+/*
+ * This function frees the memory associated with a B+ tree iterator.
+ *
+ * Params:
+ *   iter - the iterator to be destroyed.  May not be NULL.
+ */
+void btree_iterator_free(struct btree_iterator* iter) {
+  free(iter);
+}
+
+/*
+ * This function returns 1 if a B+ tree iterator has more keys to return, or
+ * 0 otherwise.
+ *
+ * Params:
+ *   iter - the iterator to be checked.  May not be NULL.
+ */
+int btree_iterator_has_next(struct btree_iterator* iter) {
+  return iter->leaf != NULL && iter->leaf->node.keys[iter->index] <= iter->upper;
+}
+
+/*
+ * This function returns the next key from a B+ tree iterator and stores its
+ * value at `value` (if `value` isn't NULL).  It may only be called if
+ * btree_iterator_has_next() returns 1.
+ *
+ * Params:
+ *   iter - the iterator.  May not be NULL.
+ *   value - pointer at which the key's value should be stored.
+ *
+ * Return:
+ *   Should return the next key in order.
+ */
+int btree_iterator_next(struct btree_iterator* iter, void** value) {
+
+  struct btree_leaf* leaf = iter->leaf;
+  int key = leaf->node.keys[iter->index];
+
+  if(value != NULL) {
+    *value = leaf->values[iter->index];
+  }
+
+  //moves on to the next leaf once this one is used up
+  if(++iter->index == leaf->node.n) {
+    iter->leaf = leaf->next;
+    iter->index = 0;
+  }
+
+  return key;
+}
@@ -0,0 +1,43 @@
+/*
+ * This file contains the definition of the interface for a B+ tree, an
+ * ordered map like the BST in bst.h that stores many keys per node.  You can
+ * find descriptions of the B+ tree functions, including their parameters and
+ * their return values, in btree.c.
+ */
+
+#ifndef __BTREE_H
+#define __BTREE_H
+
+/*
+ * Structure used to represent a B+ tree.
+ */
+struct btree;
+
+/*
+ * B+ tree interface function prototypes.  Refer to btree.c for documentation
+ * about each of these functions.
+ */
+struct btree* btree_create();
+void btree_free(struct btree* btree);
+int btree_size(struct btree* btree);
+void btree_insert(struct btree* btree, int key, void* value);
+void btree_remove(struct btree* btree, int key);
+void* btree_get(struct btree* btree, int key);
+int btree_range_sum(struct btree* btree, int lower, int upper);
+
+/*
+ * Structure used to represent a B+ tree iterator.
+ */
+struct btree_iterator;
+
+/*
+ * B+ tree iterator interface prototypes.  Refer to btree.c for documentation
+ * about each of these functions.
+ */
+struct btree_iterator* btree_iterator_create(struct btree* btree);
+struct btree_iterator* btree_iterator_create_range(struct btree* btree, int lower, int upper);
+void btree_iterator_free(struct btree_iterator* iter);
+int btree_iterator_has_next(struct btree_iterator* iter);
+int btree_iterator_next(struct btree_iterator* iter, void** value);
+
+#endif
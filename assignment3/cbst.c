@@ -0,0 +1,507 @@
+/*
+ * This file contains the implementation of a concurrent BST.  It is an AVL
+ * tree like the one in bst.c, but its nodes are never changed once other
+ * threads can see them.  A writer builds new copies of the nodes on the path
+ * it changes (plus any nodes touched by rotations), pointing at the unchanged
+ * subtrees of the old tree, and then publishes the new root with a single
+ * atomic store.  The nodes it replaced are handed to epoch_retire() so they
+ * aren't freed while a reader might still be looking at them.
+ *
+ * Readers just load the root and walk down from it, inside an epoch critical
+ * section.  They never take a lock or write to any shared memory, so a lookup
+ * doesn't bounce cache lines between cores no matter how many threads are
+ * reading, and every reader sees a consistent snapshot of the tree.
+ *
+ * Writers take a mutex.  Each write replaces the root, so two writers can
+ * never both succeed on the same tree version without one redoing its work;
+ * finer-grained writer locks wouldn't let writes run in parallel here.
+ *
+ * Name: Gabriel de Leon
+ * Email: deleong@oregonstate.edu
+ */
+
+#include <stdlib.h>
+#include <pthread.h>
+
+#include "cbst.h"
+#include "epoch.h"
+
+/*
+ * This is the largest height an AVL tree with fewer than 2^31 nodes can have,
+ * as in bst.c.
+ */
+#define CBST_MAX_HEIGHT 48
+
+/*
+ * This structure represents a single node in a concurrent BST.  `version` is
+ * the number of the write that created the node.
+ */
+struct cbst_node {
+  int key;
+  int height;
+  long long sum;
+  void* value;
+  struct cbst_node* left;
+  struct cbst_node* right;
+  unsigned long version;
+};
+
+/*
+ * This structure represents an entire concurrent BST.  `version` counts the
+ * writes made to the tree.  `root`, `size` and `version` are only written by
+ * the thread holding `lock`.
+ */
+struct cbst {
+  struct cbst_node* root;
+  int size;
+  unsigned long version;
+  pthread_mutex_t lock;
+};
+
+/*
+ * This structure represents an iterator over a snapshot of a concurrent BST.
+ */
+struct cbst_iterator {
+  struct cbst_node* stack[CBST_MAX_HEIGHT];
+  int top;
+};
+
+/*
+ * These functions return the height and key sum of a subtree, treating an
+ * empty subtree as having height 0 and sum 0.
+ */
+static int node_height(struct cbst_node* node) {
+  return node ? node->height : 0;
+}
+
+static long long node_sum(struct cbst_node* node) {
+  return node ? node->sum : 0;
+}
+
+/*
+ * This function loads the current root of a tree.  Every node reachable from
+ * it was fully written before it was published.
+ */
+static struct cbst_node* load_root(struct cbst* cbst) {
+  return __atomic_load_n(&cbst->root, __ATOMIC_ACQUIRE);
+}
+
+/*
+ * This function allocates a new node for the write in progress.
+ */
+static struct cbst_node* node_create(struct cbst* cbst, int key, void* value,
+    struct cbst_node* left, struct cbst_node* right) {
+
+  struct cbst_node* node = malloc(sizeof(struct cbst_node));
+  node->key = key;
+  node->value = value;
+  node->left = left;
+  node->right = right;
+  node->version = cbst->version;
+
+  int hl = node_height(left), hr = node_height(right);
+  node->height = 1 + (hl > hr ? hl : hr);
+  node->sum = node_sum(left) + node_sum(right) + key;
+
+  return node;
+}
+
+/*
+ * This function gets rid of a node that the write in progress has replaced.
+ * A node created by this same write has never been seen by another thread and
+ * can be freed right away; any other node may still be in use by a reader.
+ */
+static void node_discard(struct cbst* cbst, struct cbst_node* node) {
+  if(node->version == cbst->version) {
+    free(node);
+  }
+  else {
+    epoch_retire(node, free);
+  }
+}
+
+/*
+ * This function builds a node with the given key, value and children, doing a
+ * single or double rotation if the children's heights differ by two.  Nodes
+ * taken apart by a rotation are discarded.
+ */
+static struct cbst_node* balance(struct cbst* cbst, int key, void* value,
+    struct cbst_node* left, struct cbst_node* right) {
+
+  struct cbst_node* result;
+
+  //left side is too tall
+  if(node_height(left) > node_height(right) + 1) {
+    if(node_height(left->left) >= node_height(left->right)) {
+      result = node_create(cbst, left->key, left->value, left->left,
+        node_create(cbst, key, value, left->right, right));
+    }
+    else {
+      struct cbst_node* middle = left->right;
+      result = node_create(cbst, middle->key, middle->value,
+        node_create(cbst, left->key, left->value, left->left, middle->left),
+        node_create(cbst, key, value, middle->right, right));
+      node_discard(cbst, middle);
+    }
+    node_discard(cbst, left);
+    return result;
+  }
+
+  //right side is too tall
+  if(node_height(right) > node_height(left) + 1) {
+    if(node_height(right->right) >= node_height(right->left)) {
+      result = node_create(cbst, right->key, right->value,
+        node_create(cbst, key, value, left, right->left), right->right);
+    }
+    else {
+      struct cbst_node* middle = right->left;
+      result = node_create(cbst, middle->key, middle->value,
+        node_create(cbst, key, value, left, middle->left),
+        node_create(cbst, right->key, right->value, middle->right, right->right));
+      node_discard(cbst, middle);
+    }
+    node_discard(cbst, right);
+    return result;
+  }
+
+  return node_create(cbst, key, value, left, right);
+}
+
+/*
+ * This function returns a copy of the subtree rooted at `node` with a new
+ * key/value pair added.
+ */
+static struct cbst_node* insert(struct cbst* cbst, struct cbst_node* node, int key, void* value) {
+
+  if(node == NULL) {
+    return node_create(cbst, key, value, NULL, NULL);
+  }
+
+  struct cbst_node* result;
+  if(key < node->key) {
+    result = balance(cbst, node->key, node->value, insert(cbst, node->left, key, value), node->right);
+  }
+  else {
+    result = balance(cbst, node->key, node->value, node->left, insert(cbst, node->right, key, value));
+  }
+
+  node_discard(cbst, node);
+  return result;
+}
+
+/*
+ * This function returns a copy of the subtree rooted at `node` without its
+ * smallest node, which is stored in `min` (and not discarded).
+ */
+static struct cbst_node* remove_min(struct cbst* cbst, struct cbst_node* node, struct cbst_node** min) {
+
+  if(node->left == NULL) {
+    *min = node;
+    return node->right;
+  }
+
+  struct cbst_node* result = balance(cbst, node->key, node->value,
+    remove_min(cbst, node->left, min), node->right);
+  node_discard(cbst, node);
+  return result;
+}
+
+/*
+ * This function returns a copy of the subtree rooted at `node` with one node
+ * holding `key` removed.  If there is no such node, the subtree is returned
+ * unchanged and `removed` is left alone; otherwise `removed` is set to 1.
+ */
+static struct cbst_node* remove_key(struct cbst* cbst, struct cbst_node* node, int key, int* removed) {
+
+  if(node == NULL) {
+    return NULL;
+  }
+
+  struct cbst_node* result;
+
+  if(key == node->key) {
+    *removed = 1;
+    if(node->left == NULL) {
+      result = node->right;
+    }
+    else if(node->right == NULL) {
+      result = node->left;
+    }
+    else {
+      struct cbst_node* min;
+      struct cbst_node* right = remove_min(cbst, node->right, &min);
+      result = balance(cbst, min->key, min->value, node->left, right);
+      node_discard(cbst, min);
+    }
+  }
+
+  else if(key < node->key) {
+    struct cbst_node* left = remove_key(cbst, node->left, key, removed);
+    if(!*removed) {
+      return node;
+    }
+    result = balance(cbst, node->key, node->value, left, node->right);
+  }
+
+  else {
+    struct cbst_node* right = remove_key(cbst, node->right, key, removed);
+    if(!*removed) {
+      return node;
+    }
+    result = balance(cbst, node->key, node->value, node->left, right);
+  }
+
+  node_discard(cbst, node);
+  return result;
+}
+
+/*
+ * This function frees a node and all of its descendants.
+ */
+static void node_free(struct cbst_node* node) {
+  if(node != NULL) {
+    node_free(node->left);
+    node_free(node->right);
+    free(node);
+  }
+}
+
+/*
+ * This function returns the sum of the keys in the subtree rooted at `node`
+ * that are less than `key` (or less than or equal to `key`, if `inclusive` is
+ * nonzero).
+ */
+static long long prefix(struct cbst_node* node, int key, int inclusive) {
+  long long sum = 0;
+  while(node != NULL) {
+    if(node->key < key || (inclusive && node->key == key)) {
+      sum += node_sum(node->left) + node->key;
+      node = node->right;
+    }
+    else {
+      node = node->left;
+    }
+  }
+  return sum;
+}
+
+/*
+ * This function should allocate and initialize a new, empty concurrent BST
+ * and return a pointer to it.
+ */
+struct cbst* cbst_create() {
+
+  struct cbst* cbst = malloc(sizeof(struct cbst));
+  cbst->root = NULL;
+  cbst->size = 0;
+  cbst->version = 0;
+  pthread_mutex_init(&cbst->lock, NULL);
+
+  return cbst;
+}
+
+/*
+ * This function frees the memory associated with a concurrent BST.  It does
+ * not free the values stored in the tree.  No other thread may be using the
+ * tree when it is freed.  Nodes retired by earlier writes are left to the
+ * epoch code (see epoch_flush()).
+ *
+ * Params:
+ *   cbst - the concurrent BST to be destroyed.  May not be NULL.
+ */
+void cbst_free(struct cbst* cbst) {
+  node_free(cbst->root);
+  pthread_mutex_destroy(&cbst->lock);
+  free(cbst);
+}
+
+/*
+ * This function returns the number of elements in a concurrent BST.  Takes
+ * O(1) time.
+ *
+ * Params:
+ *   cbst - the concurrent BST whose elements are to be counted.  May not be
+ *     NULL.
+ */
+int cbst_size(struct cbst* cbst) {
+  return __atomic_load_n(&cbst->size, __ATOMIC_RELAXED);
+}
+
+/*
+ * This function inserts a new key/value pair into a concurrent BST.  Readers
+ * see either the whole insert or none of it.  Takes O(log n) time.
+ *
+ * Params:
+ *   cbst - the concurrent BST into which to insert.  May not be NULL.
+ *   key - the key used to order the key/value pair.
+ *   value - the value to store with the key.
+ */
+void cbst_insert(struct cbst* cbst, int key, void* value) {
+
+  pthread_mutex_lock(&cbst->lock);
+  epoch_enter();
+
+  cbst->version++;
+  struct cbst_node* root = insert(cbst, cbst->root, key, value);
+  __atomic_store_n(&cbst->root, root, __ATOMIC_RELEASE);
+  __atomic_store_n(&cbst->size, cbst->size + 1, __ATOMIC_RELAXED);
+
+  epoch_exit();
+  pthread_mutex_unlock(&cbst->lock);
+}
+
+/*
+ * This function removes a key/value pair with a given key from a concurrent
+ * BST.  If the key isn't in the tree, nothing happens.  Takes O(log n) time.
+ *
+ * Params:
+ *   cbst - the concurrent BST from which to remove.  May not be NULL.
+ *   key - the key of the key/value pair to remove.
+ */
+void cbst_remove(struct cbst* cbst, int key) {
+
+  pthread_mutex_lock(&cbst->lock);
+  epoch_enter();
+
+  int removed = 0;
+  cbst->version++;
+  struct cbst_node* root = remove_key(cbst, cbst->root, key, &removed);
+  if(removed) {
+    __atomic_store_n(&cbst->root, root, __ATOMIC_RELEASE);
+    __atomic_store_n(&cbst->size, cbst->size - 1, __ATOMIC_RELAXED);
+  }
+
+  epoch_exit();
+  pthread_mutex_unlock(&cbst->lock);
+}
+
+/*
+ * This function returns the value associated with a key in a concurrent BST.
+ * It never takes a lock.  Takes O(log n) time.
+ *
+ * Params:
+ *   cbst - the concurrent BST to search.  May not be NULL.
+ *   key - the key whose value is to be returned.
+ *
+ * Return:
+ *   Should return the value associated with `key`, or NULL if `key` isn't in
+ *   the tree.
+ */
+void* cbst_get(struct cbst* cbst, int key) {
+
+  void* value = NULL;
+  epoch_enter();
+
+  struct cbst_node* node = load_root(cbst);
+  while(node != NULL) {
+    if(key == node->key) {
+      value = node->value;
+      break;
+    }
+    node = (key < node->key) ? node->left : node->right;
+  }
+
+  epoch_exit();
+  return value;
+}
+
+/*
+ * This function returns the sum of the keys in a concurrent BST between a
+ * lower and an upper bound (both inclusive), all taken from the same snapshot
+ * of the tree.  It never takes a lock.  Takes O(log n) time.
+ *
+ * Params:
+ *   cbst - the concurrent BST within which to compute a range sum.  May not be
+ *     NULL.
+ *   lower - the inclusive lower bound of the range.
+ *   upper - the inclusive upper bound of the range.
+ */
+int cbst_range_sum(struct cbst* cbst, int lower, int upper) {
+
+  if(lower > upper) {
+    return 0;
+  }
+
+  epoch_enter();
+  struct cbst_node* root = load_root(cbst);
+  long long sum = prefix(root, upper, 1) - prefix(root, lower, 0);
+  epoch_exit();
+
+  return (int)sum;
+}
+
+/*
+ * This function allocates an iterator over a snapshot of a concurrent BST.
+ * Writes made after the iterator is created aren't seen by it.  The calling
+ * thread stays in an epoch critical section until the iterator is freed, so
+ * the iterator must be freed by the thread that created it, and nodes retired
+ * in the meantime can't be reclaimed until it is.
+ *
+ * Params:
+ *   cbst - the concurrent BST over which to iterate.  May not be NULL.
+ */
+struct cbst_iterator* cbst_iterator_create(struct cbst* cbst) {
+
+  struct cbst_iterator* iter = malloc(sizeof(struct cbst_iterator));
+  iter->top = 0;
+
+  epoch_enter();
+  struct cbst_node* node = load_root(cbst);
+  while(node != NULL) {
+    iter->stack[iter->top++] = node;
+    node = node->left;
+  }
+
+  return iter;
+}
+
+/*
+ * This function frees the memory associated with a concurrent BST iterator
+ * and ends its epoch critical section.
+ *
+ * Params:
+ *   iter - the iterator to be destroyed.  May not be NULL.
+ */
+void cbst_iterator_free(struct cbst_iterator* iter) {
+  epoch_exit();
+  free(iter);
+}
+
+/*
+ * This function returns 1 if a concurrent BST iterator has more keys to
+ * return, or 0 otherwise.
+ *
+ * Params:
+ *   iter - the iterator to be checked.  May not be NULL.
+ */
+int cbst_iterator_has_next(struct cbst_iterator* iter) {
+  return iter->top > 0;
+}
+
+/*
+ * This function returns the next key from a concurrent BST iterator, in
+ * order, and stores its value at `value` (if `value` isn't NULL).  It may only
+ * be called if cbst_iterator_has_next() returns 1.
+ *
+ * Params:
+ *   iter - the iterator.  May not be NULL.
+ *   value - pointer at which the key's value should be stored.
+ *
+ * Return:
+ *   Should return the next key in order.
+ */
+int cbst_iterator_next(struct cbst_iterator* iter, void** value) {
+
+  struct cbst_node* node = iter->stack[--iter->top];
+  if(value != NULL) {
+    *value = node->value;
+  }
+
+  struct cbst_node* child = node->right;
+  while(child != NULL) {
+    iter->stack[iter->top++] = child;
+    child = child->left;
+  }
+
+  return node->key;
+}
@@ -0,0 +1,43 @@
+/*
+ * This file contains the definition of the interface for a concurrent BST,
+ * an ordered map that many threads can use at once.  Lookups, range sums and
+ * iteration never take a lock.  You can find descriptions of the concurrent
+ * BST functions, including their parameters and their return values, in
+ * cbst.c.
+ */
+
+#ifndef __CBST_H
+#define __CBST_H
+
+/*
+ * Structure used to represent a concurrent BST.
+ */
+struct cbst;
+
+/*
+ * Concurrent BST interface function prototypes.  Refer to cbst.c for
+ * documentation about each of these functions.
+ */
+struct cbst* cbst_create();
+void cbst_free(struct cbst* cbst);
+int cbst_size(struct cbst* cbst);
+void cbst_insert(struct cbst* cbst, int key, void* value);
+void cbst_remove(struct cbst* cbst, int key);
+void* cbst_get(struct cbst* cbst, int key);
+int cbst_range_sum(struct cbst* cbst, int lower, int upper);
+
+/*
+ * Structure used to represent a concurrent BST iterator.
+ */
+struct cbst_iterator;
+
+/*
+ * Concurrent BST iterator interface prototypes.  Refer to cbst.c for
+ * documentation about each of these functions.
+ */
+struct cbst_iterator* cbst_iterator_create(struct cbst* cbst);
+void cbst_iterator_free(struct cbst_iterator* iter);
+int cbst_iterator_has_next(struct cbst_iterator* iter);
+int cbst_iterator_next(struct cbst_iterator* iter, void** value);
+
+#endif
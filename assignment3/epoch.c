@@ -0,0 +1,220 @@
+/*
+ * This file contains an implementation of epoch-based memory reclamation.
+ *
+ * Lock-free data structures can't free a node as soon as it is unlinked,
+ * because another thread might be in the middle of reading it.  Instead,
+ * threads wrap every access to shared nodes in epoch_enter()/epoch_exit()
+ * (a "critical section"), and unlinked nodes are handed to epoch_retire().
+ *
+ * There is a global epoch counter.  A thread entering a critical section
+ * announces the epoch it saw, and the global epoch can only move forward once
+ * every thread that is inside a critical section has announced the current
+ * epoch.  A node retired during epoch e was unlinked before any thread could
+ * announce epoch e + 1, so once the global epoch reaches e + 2 no thread can
+ * still hold a reference to it and it can be freed.  Each thread keeps three
+ * "limbo" lists of retired nodes, one for each epoch modulo 3.
+ *
+ * Name: Gabriel de Leon
+ * Email: deleong@oregonstate.edu
+ */
+
+#include <stdlib.h>
+#include <assert.h>
+
+#include "epoch.h"
+
+/*
+ * This is the number of nodes a thread retires between attempts to advance
+ * the global epoch.
+ */
+#define EPOCH_RETIRE_THRESHOLD 64
+
+/*
+ * This structure represents a single retired node waiting to be freed.
+ */
+struct epoch_limbo {
+    void* ptr;
+    void (*free_fn)(void* ptr);
+    struct epoch_limbo* next;
+};
+
+/*
+ * This structure represents the epoch state of a single thread.  `state`
+ * holds the epoch the thread announced shifted left by one, with the lowest
+ * bit set while the thread is inside a critical section.  `depth` counts
+ * nested calls to epoch_enter().  Records are linked into a global list and
+ * are never freed, so a thread that exits simply leaves an inactive record
+ * behind.
+ */
+struct epoch_record {
+    unsigned long state;
+    unsigned long epoch;
+    int depth;
+    int retired;
+    struct epoch_limbo* limbo[3];
+    struct epoch_record* next;
+};
+
+/*
+ * These are the global epoch and the list of all thread records.
+ */
+static unsigned long global_epoch = 0;
+static struct epoch_record* records = NULL;
+
+/*
+ * This is the calling thread's record, created the first time the thread
+ * uses epoch reclamation.
+ */
+static __thread struct epoch_record* thread_record = NULL;
+
+/*
+ * This function frees every node in a limbo list.
+ */
+static void limbo_free(struct epoch_limbo* limbo)
+{
+    while(limbo != NULL) {
+        struct epoch_limbo* temp = limbo;
+        limbo = limbo->next;
+        temp->free_fn(temp->ptr);
+        free(temp);
+    }
+}
+
+/*
+ * This function returns the calling thread's record, allocating it and
+ * pushing it onto the global list of records if needed.
+ */
+static struct epoch_record* get_record()
+{
+    if(thread_record != NULL) {
+        return thread_record;
+    }
+
+    struct epoch_record* rec = malloc(sizeof(struct epoch_record));
+    rec->state = 0;
+    rec->epoch = __atomic_load_n(&global_epoch, __ATOMIC_ACQUIRE);
+    rec->depth = 0;
+    rec->retired = 0;
+    for(int i = 0; i < 3; i++) {
+        rec->limbo[i] = NULL;
+    }
+
+    //lock-free push onto the front of the global list
+    rec->next = __atomic_load_n(&records, __ATOMIC_ACQUIRE);
+    while(!__atomic_compare_exchange_n(&records, &rec->next, rec, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+
+    thread_record = rec;
+
+    return rec;
+}
+
+/*
+ * This function tries to move the global epoch forward by one.  This only
+ * succeeds if every thread that is inside a critical section has already
+ * announced the current epoch.
+ */
+static void try_advance()
+{
+    unsigned long epoch = __atomic_load_n(&global_epoch, __ATOMIC_SEQ_CST);
+
+    //checks for any active thread that is still in an older epoch
+    struct epoch_record* rec = __atomic_load_n(&records, __ATOMIC_ACQUIRE);
+    while(rec != NULL) {
+        unsigned long state = __atomic_load_n(&rec->state, __ATOMIC_SEQ_CST);
+        if((state & 1) && (state >> 1) != epoch) {
+            return;
+        }
+        rec = rec->next;
+    }
+
+    //another thread may have advanced the epoch already, which is fine
+    __atomic_compare_exchange_n(&global_epoch, &epoch, epoch + 1, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+/*
+ * This function starts a critical section for the calling thread.  Shared
+ * nodes may only be read between a call to this function and the matching
+ * call to epoch_exit().  Critical sections may be nested.
+ */
+void epoch_enter()
+{
+    struct epoch_record* rec = get_record();
+
+    if(rec->depth++ > 0) {
+        return;
+    }
+
+    unsigned long epoch = __atomic_load_n(&global_epoch, __ATOMIC_SEQ_CST);
+
+    //nodes this thread retired three or more epochs ago are now safe to free
+    if(epoch != rec->epoch) {
+        limbo_free(rec->limbo[epoch % 3]);
+        rec->limbo[epoch % 3] = NULL;
+        rec->epoch = epoch;
+    }
+
+    //announces the epoch before any shared node is read
+    __atomic_store_n(&rec->state, (epoch << 1) | 1, __ATOMIC_SEQ_CST);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+/*
+ * This function ends a critical section started by epoch_enter().
+ */
+void epoch_exit()
+{
+    struct epoch_record* rec = thread_record;
+    assert(rec && rec->depth > 0);
+
+    if(--rec->depth > 0) {
+        return;
+    }
+
+    __atomic_store_n(&rec->state, rec->epoch << 1, __ATOMIC_RELEASE);
+}
+
+/*
+ * This function hands a node that has been unlinked from a shared data
+ * structure over to be freed once no thread can still be reading it.  It must
+ * be called from inside a critical section.
+ *
+ * Params:
+ * ptr - the node to be freed.
+ * free_fn - the function that will be called to free `ptr`.
+ */
+void epoch_retire(void* ptr, void (*free_fn)(void* ptr))
+{
+    struct epoch_record* rec = thread_record;
+    assert(rec && rec->depth > 0);
+
+    struct epoch_limbo* limbo = malloc(sizeof(struct epoch_limbo));
+    limbo->ptr = ptr;
+    limbo->free_fn = free_fn;
+    limbo->next = rec->limbo[rec->epoch % 3];
+    rec->limbo[rec->epoch % 3] = limbo;
+
+    //every so often, tries to move the epoch along so memory gets reclaimed
+    if(++rec->retired >= EPOCH_RETIRE_THRESHOLD) {
+        rec->retired = 0;
+        try_advance();
+    }
+}
+
+/*
+ * This function immediately frees every retired node of every thread.  It may
+ * only be called when no thread is inside a critical section, for example
+ * after all worker threads have been joined.
+ */
+void epoch_flush()
+{
+    struct epoch_record* rec = __atomic_load_n(&records, __ATOMIC_ACQUIRE);
+
+    while(rec != NULL) {
+        assert((rec->state & 1) == 0);
+        for(int i = 0; i < 3; i++) {
+            limbo_free(rec->limbo[i]);
+            rec->limbo[i] = NULL;
+        }
+        rec = rec->next;
+    }
+}
@@ -0,0 +1,448 @@
+/*
+ * This file contains the implementation of a persistent BST.  It is an AVL
+ * tree like the one in bst.c, but its nodes are never changed after they are
+ * created.  An insert or remove copies only the nodes on the path it changes
+ * (plus any nodes touched by rotations) and shares every other subtree with
+ * the version it started from, so it takes O(log n) time and memory no matter
+ * how many versions are alive.
+ *
+ * Since a node can be shared by many versions, each node counts the parents
+ * (nodes or versions) pointing at it, and it is freed when that count drops
+ * to zero.  The counts are updated atomically, so different threads can
+ * create and free versions that share nodes.  A thread can take a snapshot of
+ * a tree and run long range sums over it while other threads keep making new
+ * versions.
+ *
+ * Name: Gabriel de Leon
+ * Email: deleong@oregonstate.edu
+ */
+
+#include <stdlib.h>
+
+#include "pbst.h"
+
+/*
+ * This is the largest height an AVL tree with fewer than 2^31 nodes can have,
+ * as in bst.c.
+ */
+#define PBST_MAX_HEIGHT 48
+
+/*
+ * This structure represents a single node in a persistent BST.  `refs` is
+ * the number of nodes and versions pointing at the node.
+ */
+struct pbst_node {
+  int key;
+  int height;
+  int refs;
+  long long sum;
+  void* value;
+  struct pbst_node* left;
+  struct pbst_node* right;
+};
+
+/*
+ * This structure represents one version of a persistent BST.
+ */
+struct pbst {
+  struct pbst_node* root;
+  int size;
+};
+
+/*
+ * This structure represents an iterator over one version of a persistent BST.
+ */
+struct pbst_iterator {
+  struct pbst_node* stack[PBST_MAX_HEIGHT];
+  int top;
+};
+
+/*
+ * These functions return the height and key sum of a subtree, treating an
+ * empty subtree as having height 0 and sum 0.
+ */
+static int node_height(struct pbst_node* node) {
+  return node ? node->height : 0;
+}
+
+static long long node_sum(struct pbst_node* node) {
+  return node ? node->sum : 0;
+}
+
+/*
+ * This function adds a reference to a node (if it isn't NULL) and returns it.
+ */
+static struct pbst_node* node_retain(struct pbst_node* node) {
+  if(node != NULL) {
+    __atomic_add_fetch(&node->refs, 1, __ATOMIC_RELAXED);
+  }
+  return node;
+}
+
+/*
+ * This function drops a reference to a node.  If it was the last one, the
+ * node is freed and its references to its children are dropped in turn.
+ */
+static void node_release(struct pbst_node* node) {
+  while(node != NULL && __atomic_sub_fetch(&node->refs, 1, __ATOMIC_ACQ_REL) == 0) {
+    struct pbst_node* right = node->right;
+    node_release(node->left);
+    free(node);
+    node = right;
+  }
+}
+
+/*
+ * This function allocates a new node with the given key, value and children.
+ * The new node takes over the caller's references to `left` and `right`, and
+ * the caller gets the only reference to the new node.
+ */
+static struct pbst_node* node_create(int key, void* value, struct pbst_node* left, struct pbst_node* right) {
+
+  struct pbst_node* node = malloc(sizeof(struct pbst_node));
+  node->key = key;
+  node->value = value;
+  node->refs = 1;
+  node->left = left;
+  node->right = right;
+
+  int hl = node_height(left), hr = node_height(right);
+  node->height = 1 + (hl > hr ? hl : hr);
+  node->sum = node_sum(left) + node_sum(right) + key;
+
+  return node;
+}
+
+/*
+ * This function builds a node like node_create(), doing a single or double
+ * rotation if the children's heights differ by two.  A child taken apart by a
+ * rotation is released, so it's freed if it was only just created.
+ */
+static struct pbst_node* balance(int key, void* value, struct pbst_node* left, struct pbst_node* right) {
+
+  struct pbst_node* result;
+
+  //left side is too tall
+  if(node_height(left) > node_height(right) + 1) {
+    if(node_height(left->left) >= node_height(left->right)) {
+      result = node_create(left->key, left->value, node_retain(left->left),
+        node_create(key, value, node_retain(left->right), right));
+    }
+    else {
+      struct pbst_node* middle = left->right;
+      result = node_create(middle->key, middle->value,
+        node_create(left->key, left->value, node_retain(left->left), node_retain(middle->left)),
+        node_create(key, value, node_retain(middle->right), right));
+    }
+    node_release(left);
+    return result;
+  }
+
+  //right side is too tall
+  if(node_height(right) > node_height(left) + 1) {
+    if(node_height(right->right) >= node_height(right->left)) {
+      result = node_create(right->key, right->value,
+        node_create(key, value, left, node_retain(right->left)), node_retain(right->right));
+    }
+    else {
+      struct pbst_node* middle = right->left;
+      result = node_create(middle->key, middle->value,
+        node_create(key, value, left, node_retain(middle->left)),
+        node_create(right->key, right->value, node_retain(middle->right), node_retain(right->right)));
+    }
+    node_release(right);
+    return result;
+  }
+
+  return node_create(key, value, left, right);
+}
+
+/*
+ * This function returns a new subtree holding the keys of the subtree rooted
+ * at `node` plus a new key/value pair.  `node` itself isn't changed.
+ */
+static struct pbst_node* insert(struct pbst_node* node, int key, void* value) {
+
+  if(node == NULL) {
+    return node_create(key, value, NULL, NULL);
+  }
+
+  if(key < node->key) {
+    return balance(node->key, node->value, insert(node->left, key, value), node_retain(node->right));
+  }
+
+  return balance(node->key, node->value, node_retain(node->left), insert(node->right, key, value));
+}
+
+/*
+ * This function returns a new subtree holding the keys of the subtree rooted
+ * at `node` except its smallest, which is stored in `min`.
+ */
+static struct pbst_node* remove_min(struct pbst_node* node, struct pbst_node** min) {
+
+  if(node->left == NULL) {
+    *min = node;
+    return node_retain(node->right);
+  }
+
+  return balance(node->key, node->value, remove_min(node->left, min), node_retain(node->right));
+}
+
+/*
+ * This function returns a new subtree holding the keys of the subtree rooted
+ * at `node` with one copy of `key` removed, setting `removed` to 1 if there
+ * was one.  If there wasn't, a new reference to `node` is returned.
+ */
+static struct pbst_node* remove_key(struct pbst_node* node, int key, int* removed) {
+
+  if(node == NULL) {
+    return NULL;
+  }
+
+  if(key == node->key) {
+    *removed = 1;
+    if(node->left == NULL) {
+      return node_retain(node->right);
+    }
+    if(node->right == NULL) {
+      return node_retain(node->left);
+    }
+
+    struct pbst_node* min;
+    struct pbst_node* right = remove_min(node->right, &min);
+    return balance(min->key, min->value, node_retain(node->left), right);
+  }
+
+  if(key < node->key) {
+    struct pbst_node* left = remove_key(node->left, key, removed);
+    if(!*removed) {
+      node_release(left);
+      return node_retain(node);
+    }
+    return balance(node->key, node->value, left, node_retain(node->right));
+  }
+
+  struct pbst_node* right = remove_key(node->right, key, removed);
+  if(!*removed) {
+    node_release(right);
+    return node_retain(node);
+  }
+  return balance(node->key, node->value, node_retain(node->left), right);
+}
+
+/*
+ * This function returns the sum of the keys in the subtree rooted at `node`
+ * that are less than `key` (or less than or equal to `key`, if `inclusive` is
+ * nonzero).
+ */
+static long long prefix(struct pbst_node* node, int key, int inclusive) {
+  long long sum = 0;
+  while(node != NULL) {
+    if(node->key < key || (inclusive && node->key == key)) {
+      sum += node_sum(node->left) + node->key;
+      node = node->right;
+    }
+    else {
+      node = node->left;
+    }
+  }
+  return sum;
+}
+
+/*
+ * This function allocates a version pointing at `root`, taking over the
+ * caller's reference to it.
+ */
+static struct pbst* version_create(struct pbst_node* root, int size) {
+  struct pbst* pbst = malloc(sizeof(struct pbst));
+  pbst->root = root;
+  pbst->size = size;
+  return pbst;
+}
+
+/*
+ * This function should allocate and initialize a new, empty persistent BST
+ * and return a pointer to it.
+ */
+struct pbst* pbst_create() {
+  return version_create(NULL, 0);
+}
+
+/*
+ * This function returns a new handle to the same version of a persistent BST
+ * in O(1) time, without copying any nodes.  The snapshot can be handed to
+ * another thread and must be freed separately with pbst_free().
+ *
+ * Params:
+ *   pbst - the version to take a snapshot of.  May not be NULL.
+ */
+struct pbst* pbst_snapshot(struct pbst* pbst) {
+  return version_create(node_retain(pbst->root), pbst->size);
+}
+
+/*
+ * This function frees one version of a persistent BST.  Nodes it shares with
+ * versions that are still alive aren't freed.  It does not free the values
+ * stored in the tree.
+ *
+ * Params:
+ *   pbst - the version to be destroyed.  May not be NULL.
+ */
+void pbst_free(struct pbst* pbst) {
+  node_release(pbst->root);
+  free(pbst);
+}
+
+/*
+ * This function returns the number of elements in a version of a persistent
+ * BST.  Takes O(1) time.
+ *
+ * Params:
+ *   pbst - the version whose elements are to be counted.  May not be NULL.
+ */
+int pbst_size(struct pbst* pbst) {
+  return pbst->size;
+}
+
+/*
+ * This function returns a new version of a persistent BST with a key/value
+ * pair added.  `pbst` isn't changed, and both versions must be freed.  Takes
+ * O(log n) time and memory.
+ *
+ * Params:
+ *   pbst - the version to insert into.  May not be NULL.
+ *   key - the key used to order the key/value pair.
+ *   value - the value to store with the key.
+ */
+struct pbst* pbst_insert(struct pbst* pbst, int key, void* value) {
+  return version_create(insert(pbst->root, key, value), pbst->size + 1);
+}
+
+/*
+ * This function returns a new version of a persistent BST with a key/value
+ * pair with a given key removed.  If the key isn't in the tree, the new
+ * version holds the same keys.  `pbst` isn't changed, and both versions must
+ * be freed.  Takes O(log n) time and memory.
+ *
+ * Params:
+ *   pbst - the version to remove from.  May not be NULL.
+ *   key - the key of the key/value pair to remove.
+ */
+struct pbst* pbst_remove(struct pbst* pbst, int key) {
+  int removed = 0;
+  struct pbst_node* root = remove_key(pbst->root, key, &removed);
+  return version_create(root, pbst->size - removed);
+}
+
+/*
+ * This function returns the value associated with a key in a version of a
+ * persistent BST.  Takes O(log n) time.
+ *
+ * Params:
+ *   pbst - the version to search.  May not be NULL.
+ *   key - the key whose value is to be returned.
+ *
+ * Return:
+ *   Should return the value associated with `key`, or NULL if `key` isn't in
+ *   this version.
+ */
+void* pbst_get(struct pbst* pbst, int key) {
+
+  struct pbst_node* node = pbst->root;
+  while(node != NULL) {
+    if(key == node->key) {
+      return node->value;
+    }
+    node = (key < node->key) ? node->left : node->right;
+  }
+
+  return NULL;
+}
+
+/*
+ * This function returns the sum of the keys in a version of a persistent BST
+ * between a lower and an upper bound (both inclusive).  Takes O(log n) time.
+ *
+ * Params:
+ *   pbst - the version within which to compute a range sum.  May not be NULL.
+ *   lower - the inclusive lower bound of the range.
+ *   upper - the inclusive upper bound of the range.
+ */
+int pbst_range_sum(struct pbst* pbst, int lower, int upper) {
+
+  if(lower > upper) {
+    return 0;
+  }
+
+  return (int)(prefix(pbst->root, upper, 1) - prefix(pbst->root, lower, 0));
+}
+
+/*
+ * This function allocates an iterator over a version of a persistent BST.
+ * The version must not be freed while the iterator is in use.
+ *
+ * Params:
+ *   pbst - the version over which to iterate.  May not be NULL.
+ */
+struct pbst_iterator* pbst_iterator_create(struct pbst* pbst) {
+
+  struct pbst_iterator* iter = malloc(sizeof(struct pbst_iterator));
+  iter->top = 0;
+
+  struct pbst_node* node = pbst->root;
+  while(node != NULL) {
+    iter->stack[iter->top++] = node;
+    node = node->left;
+  }
+
+  return iter;
+}
+
+/*
+ * This function frees the memory associated with a persistent BST iterator.
+ *
+ * Params:
+ *   iter - the iterator to be destroyed.  May not be NULL.
+ */
+void pbst_iterator_free(struct pbst_iterator* iter) {
+  free(iter);
+}
+
+/*
+ * This function returns 1 if a persistent BST iterator has more keys to
+ * return, or 0 otherwise.
+ *
+ * Params:
+ *   iter - the iterator to be checked.  May not be NULL.
+ */
+int pbst_iterator_has_next(struct pbst_iterator* iter) {
+  return iter->top > 0;
+}
+
+/*
+ * This function returns the next key from a persistent BST iterator, in
+ * order, and stores its value at `value` (if `value` isn't NULL).  It may only
+ * be called if pbst_iterator_has_next() returns 1.
+ *
+ * Params:
+ *   iter - the iterator.  May not be NULL.
+ *   value - pointer at which the key's value should be stored.
+ *
+ * Return:
+ *   Should return the next key in order.
+ */
+int pbst_iterator_next(struct pbst_iterator* iter, void** value) {
+
+  struct pbst_node* node = iter->stack[--iter->top];
+  if(value != NULL) {
+    *value = node->value;
+  }
+
+  struct pbst_node* child = node->right;
+  while(child != NULL) {
+    iter->stack[iter->top++] = child;
+    child = child->left;
+  }
+
+  return node->key;
+}
@@ -0,0 +1,44 @@
+/*
+ * This file contains the definition of the interface for a persistent BST.
+ * Inserting into or removing from a persistent BST doesn't change it, but
+ * returns a new version of the tree, and every version stays usable until it
+ * is freed.  You can find descriptions of the persistent BST functions,
+ * including their parameters and their return values, in pbst.c.
+ */
+
+#ifndef __PBST_H
+#define __PBST_H
+
+/*
+ * Structure used to represent one version of a persistent BST.
+ */
+struct pbst;
+
+/*
+ * Persistent BST interface function prototypes.  Refer to pbst.c for
+ * documentation about each of these functions.
+ */
+struct pbst* pbst_create();
+struct pbst* pbst_snapshot(struct pbst* pbst);
+void pbst_free(struct pbst* pbst);
+int pbst_size(struct pbst* pbst);
+struct pbst* pbst_insert(struct pbst* pbst, int key, void* value);
+struct pbst* pbst_remove(struct pbst* pbst, int key);
+void* pbst_get(struct pbst* pbst, int key);
+int pbst_range_sum(struct pbst* pbst, int lower, int upper);
+
+/*
+ * Structure used to represent a persistent BST iterator.
+ */
+struct pbst_iterator;
+
+/*
+ * Persistent BST iterator interface prototypes.  Refer to pbst.c for
+ * documentation about each of these functions.
+ */
+struct pbst_iterator* pbst_iterator_create(struct pbst* pbst);
+void pbst_iterator_free(struct pbst_iterator* iter);
+int pbst_iterator_has_next(struct pbst_iterator* iter);
+int pbst_iterator_next(struct pbst_iterator* iter, void** value);
+
+#endif
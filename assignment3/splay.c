@@ -0,0 +1,366 @@
+/*
+ * This file contains the implementation of a splay tree.  Every operation
+ * ends by "splaying" the last node it touched: rotating it up, two levels at
+ * a time, until it becomes the root.  The tree isn't kept balanced, but any
+ * sequence of m operations takes O(m log n) time in total, and a key that is
+ * used often stays near the root.  When a few keys get most of the lookups
+ * (as with a Zipf distribution), hot keys are found after only a few steps.
+ * Even so, bench_splay shows the AVL tree in bst.c winning: it was 4-5x
+ * faster with uniform lookups and 2-3x faster with Zipf exponents from 1.0
+ * to 1.5.  Every splay writes the pointers of each node it rotates, and here
+ * those writes cost more than the shorter paths save.
+ *
+ * Nodes have parent pointers so splaying can be done bottom-up without
+ * recursion, since paths in a splay tree can get as long as n.  Each node
+ * also stores the sum of the keys in its subtree for range sums.
+ *
+ * Name: Gabriel de Leon
+ * Email: deleong@oregonstate.edu
+ */
+
+#include <stdlib.h>
+
+#include "splay.h"
+
+/*
+ * This structure represents a single node in a splay tree.
+ */
+struct splay_node {
+  int key;
+  long long sum;
+  void* value;
+  struct splay_node* left;
+  struct splay_node* right;
+  struct splay_node* parent;
+};
+
+/*
+ * This structure represents an entire splay tree.
+ */
+struct splay {
+  struct splay_node* root;
+  int size;
+};
+
+/*
+ * This function returns the key sum of a subtree, treating an empty subtree
+ * as having sum 0.
+ */
+static long long node_sum(struct splay_node* node) {
+  return node ? node->sum : 0;
+}
+
+/*
+ * This function recomputes a node's subtree sum from its children.
+ */
+static void node_update(struct splay_node* node) {
+  node->sum = node_sum(node->left) + node_sum(node->right) + node->key;
+}
+
+/*
+ * This function rotates `node` up above its parent.  Only the two nodes'
+ * subtree sums change, since the grandparent's subtree still holds the same
+ * keys.
+ */
+static void rotate(struct splay_node* node) {
+
+  struct splay_node* parent = node->parent;
+  struct splay_node* grandparent = parent->parent;
+
+  if(node == parent->left) {
+    parent->left = node->right;
+    if(node->right != NULL) {
+      node->right->parent = parent;
+    }
+    node->right = parent;
+  }
+  else {
+    parent->right = node->left;
+    if(node->left != NULL) {
+      node->left->parent = parent;
+    }
+    node->left = parent;
+  }
+
+  parent->parent = node;
+  node->parent = grandparent;
+  if(grandparent != NULL) {
+    if(grandparent->left == parent) {
+      grandparent->left = node;
+    }
+    else {
+      grandparent->right = node;
+    }
+  }
+
+  node_update(parent);
+  node_update(node);
+}
+
+/*
+ * This function splays `node` up to the root of its tree.
+ */
+static void splay_node(struct splay_node* node) {
+
+  while(node->parent != NULL) {
+    struct splay_node* parent = node->parent;
+    struct splay_node* grandparent = parent->parent;
+
+    //zig: the parent is the root
+    if(grandparent == NULL) {
+      rotate(node);
+    }
+
+    //zig-zig: both links go the same way, so the parent goes up first
+    else if((node == parent->left) == (parent == grandparent->left)) {
+      rotate(parent);
+      rotate(node);
+    }
+
+    //zig-zag
+    else {
+      rotate(node);
+      rotate(node);
+    }
+  }
+}
+
+/*
+ * This function searches a splay tree for `key`, splays the node it stops at
+ * to the root, and returns that node if it holds `key` (or NULL otherwise).
+ */
+static struct splay_node* find(struct splay* splay, int key) {
+
+  struct splay_node* node = splay->root;
+  struct splay_node* last = NULL;
+
+  while(node != NULL && node->key != key) {
+    last = node;
+    node = (key < node->key) ? node->left : node->right;
+  }
+
+  //a miss splays the last node visited, which pays for the walk down
+  if(node != NULL) {
+    last = node;
+  }
+  if(last != NULL) {
+    splay_node(last);
+    splay->root = last;
+  }
+
+  return node;
+}
+
+/*
+ * This function returns the sum of the keys in a splay tree that are less
+ * than `key` (or less than or equal to `key`, if `inclusive` is nonzero),
+ * splaying the last node visited.
+ */
+static long long prefix(struct splay* splay, int key, int inclusive) {
+
+  struct splay_node* node = splay->root;
+  struct splay_node* last = NULL;
+  long long sum = 0;
+
+  while(node != NULL) {
+    last = node;
+    if(node->key < key || (inclusive && node->key == key)) {
+      sum += node_sum(node->left) + node->key;
+      node = node->right;
+    }
+    else {
+      node = node->left;
+    }
+  }
+
+  if(last != NULL) {
+    splay_node(last);
+    splay->root = last;
+  }
+
+  return sum;
+}
+
+/*
+ * This function frees a subtree without recursion, rotating left children up
+ * until each node has none and can be freed, like node_free() in bst.c.
+ */
+static void node_free(struct splay_node* node) {
+
+  while(node != NULL) {
+    if(node->left != NULL) {
+      struct splay_node* left = node->left;
+      node->left = left->right;
+      left->right = node;
+      node = left;
+    }
+    else {
+      struct splay_node* right = node->right;
+      free(node);
+      node = right;
+    }
+  }
+}
+
+/*
+ * This function should allocate and initialize a new, empty splay tree and
+ * return a pointer to it.
+ */
+struct splay* splay_create() {
+
+  struct splay* splay = malloc(sizeof(struct splay));
+  splay->root = NULL;
+  splay->size = 0;
+
+  return splay;
+}
+
+/*
+ * This function frees the memory associated with a splay tree.  It does not
+ * free the values stored in the tree.
+ *
+ * Params:
+ *   splay - the splay tree to be destroyed.  May not be NULL.
+ */
+void splay_free(struct splay* splay) {
+  node_free(splay->root);
+  free(splay);
+}
+
+/*
+ * This function returns the number of elements in a splay tree.  Takes O(1)
+ * time.
+ *
+ * Params:
+ *   splay - the splay tree whose elements are to be counted.  May not be
+ *     NULL.
+ */
+int splay_size(struct splay* splay) {
+  return splay->size;
+}
+
+/*
+ * This function inserts a new key/value pair into a splay tree, and splays
+ * the new node to the root.  Takes O(log n) amortized time.
+ *
+ * Params:
+ *   splay - the splay tree into which to insert.  May not be NULL.
+ *   key - the key used to order the key/value pair.
+ *   value - the value to store with the key.
+ */
+void splay_insert(struct splay* splay, int key, void* value) {
+
+  struct splay_node* node = malloc(sizeof(struct splay_node));
+  node->key = key;
+  node->sum = key;
+  node->value = value;
+  node->left = NULL;
+  node->right = NULL;
+  node->parent = NULL;
+  splay->size++;
+
+  if(splay->root == NULL) {
+    splay->root = node;
+    return;
+  }
+
+  //walks down to the empty spot for the key, adding it to each sum on the way
+  struct splay_node* parent = splay->root;
+  while(1) {
+    parent->sum += key;
+    struct splay_node** child = (key < parent->key) ? &parent->left : &parent->right;
+    if(*child == NULL) {
+      *child = node;
+      break;
+    }
+    parent = *child;
+  }
+  node->parent = parent;
+
+  splay_node(node);
+  splay->root = node;
+}
+
+/*
+ * This function removes a key/value pair with a given key from a splay tree.
+ * If the key isn't in the tree, nothing is removed, though the tree is still
+ * splayed.  Takes O(log n) amortized time.
+ *
+ * Params:
+ *   splay - the splay tree from which to remove.  May not be NULL.
+ *   key - the key of the key/value pair to remove.
+ */
+void splay_remove(struct splay* splay, int key) {
+
+  struct splay_node* node = find(splay, key);
+  if(node == NULL) {
+    return;
+  }
+
+  struct splay_node* left = node->left;
+  struct splay_node* right = node->right;
+  free(node);
+  splay->size--;
+
+  if(left == NULL) {
+    splay->root = right;
+    if(right != NULL) {
+      right->parent = NULL;
+    }
+    return;
+  }
+
+  //splays the largest key on the left up, leaving it no right child
+  left->parent = NULL;
+  while(left->right != NULL) {
+    left = left->right;
+  }
+  splay_node(left);
+
+  left->right = right;
+  if(right != NULL) {
+    right->parent = left;
+  }
+  node_update(left);
+  splay->root = left;
+}
+
+/*
+ * This function returns the value associated with a key in a splay tree, and
+ * splays that key to the root.  Takes O(log n) amortized time, and less for
+ * keys that were used recently.
+ *
+ * Params:
+ *   splay - the splay tree to search.  May not be NULL.
+ *   key - the key whose value is to be returned.
+ *
+ * Return:
+ *   Should return the value associated with `key`, or NULL if `key` isn't in
+ *   the tree.
+ */
+void* splay_get(struct splay* splay, int key) {
+  struct splay_node* node = find(splay, key);
+  return node ? node->value : NULL;
+}
+
+/*
+ * This function returns the sum of the keys in a splay tree between a lower
+ * and an upper bound (both inclusive).  Takes O(log n) amortized time.
+ *
+ * Params:
+ *   splay - the splay tree within which to compute a range sum.  May not be
+ *     NULL.
+ *   lower - the inclusive lower bound of the range.
+ *   upper - the inclusive upper bound of the range.
+ */
+int splay_range_sum(struct splay* splay, int lower, int upper) {
+
+  if(lower > upper) {
+    return 0;
+  }
+
+  long long sum = prefix(splay, upper, 1);
+  sum -= prefix(splay, lower, 0);
+
+  return (int)sum;
+}
@@ -0,0 +1,28 @@
+/*
+ * This file contains the definition of the interface for a splay tree, a BST
+ * that moves the keys it touches up to the root so that frequently used keys
+ * are quick to reach.  You can find descriptions of the splay tree functions,
+ * including their parameters and their return values, in splay.c.
+ */
+
+#ifndef __SPLAY_H
+#define __SPLAY_H
+
+/*
+ * Structure used to represent a splay tree.
+ */
+struct splay;
+
+/*
+ * Splay tree interface function prototypes.  Refer to splay.c for
+ * documentation about each of these functions.
+ */
+struct splay* splay_create();
+void splay_free(struct splay* splay);
+int splay_size(struct splay* splay);
+void splay_insert(struct splay* splay, int key, void* value);
+void splay_remove(struct splay* splay, int key);
+void* splay_get(struct splay* splay, int key);
+int splay_range_sum(struct splay* splay, int lower, int upper);
+
+#endif
@@ -74,6 +74,25 @@ int cmp_ints(const void* a, const void* b) {
   return *(int*)a - *(int*)b;
 }
 
+/*
+ * This is the number of times each key is inserted into the multimap BST.
+ */
+#define NUM_MULTIMAP_COPIES 100
+
+/*
+ * These are the size of the tree searched for path sums on several threads
+ * and the number of sums searched for.
+ */
+#define NUM_PATH_SUM_KEYS 100000
+#define NUM_PATH_SUMS_TO_CHECK 200
+
+/*
+ * This is the number of even keys put in the tree that's searched with a
+ * cursor.  Every key from 0 up to twice this is looked up, so half of them
+ * should be found.
+ */
+#define NUM_CURSOR_KEYS 100000
+
 int main(int argc, char** argv) {
   /*
    * Create a new BST and insert the testing data into it.  The testing data
@@ -136,6 +155,31 @@ int main(int argc, char** argv) {
     }
   }
 
+  /*
+   * Test looking up every key from 0 up to the largest key at once with
+   * bst_get_many(), which should find exactly the keys in the test data.
+   */
+  printf("\n== Looking up many keys at once with bst_get_many()...\n");
+  int num_lookups = sorted[NUM_TEST_DATA - 1] + 1;
+  int* lookup_keys = malloc(num_lookups * sizeof(int));
+  void** lookup_values = malloc(num_lookups * sizeof(void*));
+  for (int i = 0; i < num_lookups; i++) {
+    lookup_keys[i] = i;
+  }
+  bst_get_many(bst, lookup_keys, num_lookups, lookup_values);
+  int num_found = 0, num_wrong = 0;
+  for (int i = 0; i < num_lookups; i++) {
+    if (lookup_values[i] != bst_get(bst, i)) {
+      num_wrong++;
+    } else if (lookup_values[i] != NULL) {
+      num_found++;
+    }
+  }
+  printf("  -- found %d keys (expected %d), %d lookups disagree with "
+    "bst_get() (expected 0)\n", num_found, NUM_TEST_DATA, num_wrong);
+  free(lookup_keys);
+  free(lookup_values);
+
   /*
    * Test BST path sum function, checking several values that the tree should
    * and have as path sums.
@@ -179,6 +223,37 @@ int main(int argc, char** argv) {
   }
 
 
+  /*
+   * Test rank and select.  The rank of the i-th smallest key should be i, and
+   * selecting rank i should give back that key.
+   */
+  printf("\n== Checking ranks and selects in the BST:\n");
+  for (int i = 0; i < NUM_TEST_DATA; i++) {
+    int* value = NULL;
+    int key = bst_select(bst, i, (void**)&value);
+    printf("  -- bst_rank(%3d): %2d (expected %2d), bst_select(%2d): %3d "
+      "(expected %3d, value %3d)\n", sorted[i], bst_rank(bst, sorted[i]), i,
+      i, key, sorted[i], value ? *value : -1);
+  }
+
+  /*
+   * Test counting keys in ranges, using the same ranges as the range sums.
+   */
+  printf("\n== Checking range counts in the BST:\n");
+  for (int i = 0; i < NUM_RANGE_SUMS; i++) {
+    int lower = RANGE_SUMS[i][0];
+    int upper = RANGE_SUMS[i][1];
+    int count = 0;
+    for (int j = 0; j < NUM_TEST_DATA; j++) {
+      if (sorted[j] >= lower && sorted[j] <= upper) {
+        count++;
+      }
+    }
+    printf("  -- bst_count_range(%d, %d): %d (expected %d)\n", lower, upper,
+      bst_count_range(bst, lower, upper), count);
+  }
+
+
   /*
    * Test removing keys from the BST.  After removing each key, make sure
    * it's no longer present in the BST.
@@ -225,8 +300,174 @@ int main(int argc, char** argv) {
     }
   }
 
-  free(sorted);
   bst_free(bst);
 
+  /*
+   * Build a balanced BST straight from the sorted test data, both on one
+   * thread and on several, and make sure it matches the data.
+   */
+  int* sorted_values[NUM_TEST_DATA];
+  for (int i = 0; i < NUM_TEST_DATA; i++) {
+    sorted_values[i] = &sorted[i];
+  }
+  for (int threads = 1; threads <= 4; threads += 3) {
+    printf("\n== Building BST from sorted keys using %d thread(s)...\n",
+      threads);
+    if (threads == 1) {
+      bst = bst_create_from_sorted(sorted, (void**)sorted_values,
+        NUM_TEST_DATA);
+    } else {
+      bst = bst_create_from_sorted_parallel(sorted, (void**)sorted_values,
+        NUM_TEST_DATA, threads);
+    }
+    printf("  -- bst_size(): %d (expected %d)\n", bst_size(bst),
+      NUM_TEST_DATA);
+    printf("  -- bst_height(): %d (expected %d)\n", bst_height(bst),
+      TEST_DATA_BST_HEIGHT);
+    int num_bad_values = 0;
+    for (int i = 0; i < NUM_TEST_DATA; i++) {
+      int* value = bst_get(bst, sorted[i]);
+      if (value == NULL || *value != sorted[i]) {
+        num_bad_values++;
+      }
+    }
+    printf("  -- keys with a missing or wrong value: %d (expected 0)\n",
+      num_bad_values);
+    printf("  -- bst_range_sum(%d, %d): %d (expected %d)\n",
+      RANGE_SUMS[4][0], RANGE_SUMS[4][1],
+      bst_range_sum(bst, RANGE_SUMS[4][0], RANGE_SUMS[4][1]), RANGE_SUMS[4][2]);
+    bst_free(bst);
+  }
+
+  /*
+   * Search a bigger tree for many path sums, both sequentially and on several
+   * threads, and make sure the answers agree.  Each key repeats 1000 times,
+   * which keeps the path sums close enough together that many of the sums
+   * checked have a path.
+   */
+  printf("\n== Comparing bst_path_sum() and bst_path_sum_parallel() on %d "
+    "keys...\n", NUM_PATH_SUM_KEYS);
+  int* many_keys = malloc(NUM_PATH_SUM_KEYS * sizeof(int));
+  for (int i = 0; i < NUM_PATH_SUM_KEYS; i++) {
+    many_keys[i] = i / 1000;
+  }
+  bst = bst_create_from_sorted(many_keys, NULL, NUM_PATH_SUM_KEYS);
+  int num_disagree = 0, num_paths = 0;
+  for (int i = 0; i < NUM_PATH_SUMS_TO_CHECK; i++) {
+    int sum = 8 * i;
+    int expected = bst_path_sum(bst, sum);
+    num_paths += expected;
+    if (bst_path_sum_parallel(bst, sum, 4) != expected) {
+      num_disagree++;
+    }
+  }
+  printf("  -- sums with a path: %d, answers that disagree: %d (expected "
+    "0)\n", num_paths, num_disagree);
+  bst_free(bst);
+  free(many_keys);
+
+  /*
+   * A multimap holding one key many times is a single leaf whose size is
+   * still over the cutoff for searching on several threads.
+   */
+  bst = bst_create_multimap();
+  for (int i = 0; i < NUM_PATH_SUM_KEYS / 5; i++) {
+    bst_insert(bst, TEST_DATA[0], NULL);
+  }
+  printf("  -- bst_path_sum_parallel(%d) on a multimap with one key %d "
+    "times: %d (expected 1)\n", TEST_DATA[0], NUM_PATH_SUM_KEYS / 5,
+    bst_path_sum_parallel(bst, TEST_DATA[0], 4));
+  bst_free(bst);
+
+  /*
+   * Insert every test key several times into a multimap.  Each key should
+   * take one node, so the tree is exactly as tall as with one copy of each.
+   */
+  printf("\n== Inserting each value %d times into a multimap BST...\n",
+    NUM_MULTIMAP_COPIES);
+  bst = bst_create_multimap();
+  for (int copy = 0; copy < NUM_MULTIMAP_COPIES; copy++) {
+    for (int i = 0; i < NUM_TEST_DATA; i++) {
+      bst_insert(bst, TEST_DATA[i], (void*)&TEST_DATA[i]);
+    }
+  }
+  printf("  -- bst_size(): %d (expected %d)\n", bst_size(bst),
+    NUM_TEST_DATA * NUM_MULTIMAP_COPIES);
+  printf("  -- bst_height(): %d (expected %d)\n", bst_height(bst),
+    TEST_DATA_BST_HEIGHT);
+  printf("  -- bst_range_sum(%d, %d): %d (expected %d)\n",
+    RANGE_SUMS[4][0], RANGE_SUMS[4][1],
+    bst_range_sum(bst, RANGE_SUMS[4][0], RANGE_SUMS[4][1]),
+    RANGE_SUMS[4][2] * NUM_MULTIMAP_COPIES);
+
+  int num_values;
+  void** values = bst_get_all(bst, TEST_DATA[0], &num_values);
+  int num_bad_values = 0;
+  for (int i = 0; i < num_values; i++) {
+    if (values[i] != &TEST_DATA[0]) {
+      num_bad_values++;
+    }
+  }
+  printf("  -- bst_get_all(%d): %d values, %d wrong (expected %d values, 0 "
+    "wrong)\n", TEST_DATA[0], num_values, num_bad_values,
+    NUM_MULTIMAP_COPIES);
+
+  int num_returned = 0;
+  struct bst_iterator* iter = bst_iterator_create(bst);
+  while (bst_iterator_has_next(iter)) {
+    bst_iterator_next(iter, NULL);
+    num_returned++;
+  }
+  bst_iterator_free(iter);
+  printf("  -- keys returned by the iterator: %d (expected %d)\n",
+    num_returned, NUM_TEST_DATA * NUM_MULTIMAP_COPIES);
+
+  for (int copy = 1; copy < NUM_MULTIMAP_COPIES; copy++) {
+    bst_remove(bst, TEST_DATA[0]);
+  }
+  bst_get_all(bst, TEST_DATA[0], &num_values);
+  printf("  -- values left for %d after removing all but one: %d "
+    "(expected 1)\n", TEST_DATA[0], num_values);
+  bst_remove(bst, TEST_DATA[0]);
+  printf("  -- bst_get(%d) after removing the last one: %s (expected "
+    "NULL)\n", TEST_DATA[0], bst_get(bst, TEST_DATA[0]) ? "found" : "NULL");
+  bst_free(bst);
+
+  /*
+   * Look up every key in order with a cursor, then look a few up again after
+   * changing the tree to make sure the cursor doesn't use a stale path.
+   */
+  printf("\n== Looking up %d keys in order with a cursor...\n",
+    2 * NUM_CURSOR_KEYS);
+  int* even_keys = malloc(NUM_CURSOR_KEYS * sizeof(int));
+  void** even_values = malloc(NUM_CURSOR_KEYS * sizeof(void*));
+  for (int i = 0; i < NUM_CURSOR_KEYS; i++) {
+    even_keys[i] = 2 * i;
+    even_values[i] = &even_keys[i];
+  }
+  bst = bst_create_from_sorted(even_keys, even_values, NUM_CURSOR_KEYS);
+  struct bst_cursor* cursor = bst_cursor_create(bst);
+  num_found = 0, num_wrong = 0;
+  for (int key = 0; key < 2 * NUM_CURSOR_KEYS; key++) {
+    void* value = bst_cursor_get(cursor, key);
+    num_found += value != NULL;
+    num_wrong += value != bst_get(bst, key);
+  }
+  printf("  -- keys found: %d, values that differ from bst_get(): %d "
+    "(expected %d, 0)\n", num_found, num_wrong, NUM_CURSOR_KEYS);
+
+  bst_insert(bst, 1, &even_keys[1]);
+  bst_remove(bst, 2);
+  printf("  -- after inserting 1 and removing 2: bst_cursor_get(1): %s, "
+    "bst_cursor_get(2): %s (expected found, NULL)\n",
+    bst_cursor_get(cursor, 1) == &even_keys[1] ? "found" : "NULL",
+    bst_cursor_get(cursor, 2) ? "found" : "NULL");
+  bst_cursor_free(cursor);
+  bst_free(bst);
+  free(even_values);
+  free(even_keys);
+
+  free(sorted);
+
   return 0;
 }
@@ -0,0 +1,125 @@
+/*
+ * This file contains executable code for testing the compact BST
+ * implementation.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bst_compact.h"
+
+/*
+ * This is the same data used by test_bst.c.  It forms a tree that looks like
+ * this:
+ *
+ *               64
+ *              /  \
+ *             /    \
+ *            /      \
+ *           /        \
+ *          32        96
+ *         /  \      /  \
+ *        /    \    /    \
+ *       16    48  80    112
+ *      /  \     \   \   /  \
+ *     8   24    56  88 104 120
+ */
+#define NUM_TEST_DATA 13
+const int TEST_DATA[NUM_TEST_DATA] =
+  {64, 32, 96, 16, 48, 80, 112, 8, 24, 56, 88, 104, 120};
+
+#define TEST_DATA_BST_HEIGHT 3
+
+#define NUM_RANGE_SUMS 4
+const int RANGE_SUMS[NUM_RANGE_SUMS][3] = {
+  {8, 120, 848},
+  {2, 40, 80},
+  {60, 112, 544},
+  {125, 200, 0}
+};
+
+#define NUM_DATA_TO_REMOVE 4
+const int TEST_DATA_TO_REMOVE[NUM_DATA_TO_REMOVE] = {16, 48, 64, 104};
+
+/*
+ * This is the number of sequential keys inserted to check that the tree stays
+ * balanced as the arena grows.
+ */
+#define NUM_SEQUENTIAL_KEYS 100000
+
+int main(int argc, char** argv) {
+  printf("== Creating compact BST and inserting %d values...\n",
+    NUM_TEST_DATA);
+  struct bst_compact* bst = bst_compact_create();
+  for (int i = 0; i < NUM_TEST_DATA; i++) {
+    bst_compact_insert(bst, TEST_DATA[i], (void*)&TEST_DATA[i]);
+  }
+
+  printf("\n== Checking bst_compact_size(): %d (expected %d)\n",
+    bst_compact_size(bst), NUM_TEST_DATA);
+  printf("\n== Checking bst_compact_height(): %d (expected %d)\n",
+    bst_compact_height(bst), TEST_DATA_BST_HEIGHT);
+
+  printf("\n== Looking up values we know should be in the BST...\n");
+  for (int i = 0; i < NUM_TEST_DATA; i++) {
+    const int* value = bst_compact_get(bst, TEST_DATA[i]);
+    if (value) {
+      printf("  -- bst_compact_get(%3d): %3d (expected %3d)\n", TEST_DATA[i],
+        *value, TEST_DATA[i]);
+    } else {
+      printf("  -- bst_compact_get(%3d) unexpectedly returned NULL\n",
+        TEST_DATA[i]);
+    }
+  }
+
+  printf("\n== Checking range sums in the BST:\n");
+  for (int i = 0; i < NUM_RANGE_SUMS; i++) {
+    printf("  -- bst_compact_range_sum(%d, %d): %d (expected %d)\n",
+      RANGE_SUMS[i][0], RANGE_SUMS[i][1],
+      bst_compact_range_sum(bst, RANGE_SUMS[i][0], RANGE_SUMS[i][1]),
+      RANGE_SUMS[i][2]);
+  }
+
+  printf("\n== Removing keys from BST...\n");
+  for (int i = 0; i < NUM_DATA_TO_REMOVE; i++) {
+    bst_compact_remove(bst, TEST_DATA_TO_REMOVE[i]);
+    if (bst_compact_get(bst, TEST_DATA_TO_REMOVE[i])) {
+      printf("  -- key %3d still present in BST after removal\n",
+        TEST_DATA_TO_REMOVE[i]);
+    } else {
+      printf("  -- key %3d correctly removed from BST\n",
+        TEST_DATA_TO_REMOVE[i]);
+    }
+  }
+  printf("\n== Checking bst_compact_size(): %d (expected %d)\n",
+    bst_compact_size(bst), NUM_TEST_DATA - NUM_DATA_TO_REMOVE);
+
+  /*
+   * Insert many sequential keys, which makes the arena grow several times, and
+   * make sure the tree is still balanced and all of the keys can be found.
+   */
+  printf("\n== Inserting %d sequential keys...\n", NUM_SEQUENTIAL_KEYS);
+  for (int i = 0; i < NUM_SEQUENTIAL_KEYS; i++) {
+    bst_compact_insert(bst, 1000 + i, NULL);
+  }
+  printf("  -- bst_compact_size(): %d (expected %d)\n", bst_compact_size(bst),
+    NUM_TEST_DATA - NUM_DATA_TO_REMOVE + NUM_SEQUENTIAL_KEYS);
+  printf("  -- bst_compact_height() is at most 24: %s\n",
+    bst_compact_height(bst) <= 24 ? "yes" : "NO");
+  int num_missing = 0;
+  for (int i = 0; i < NUM_TEST_DATA; i++) {
+    int removed = 0;
+    for (int j = 0; j < NUM_DATA_TO_REMOVE; j++) {
+      removed |= TEST_DATA[i] == TEST_DATA_TO_REMOVE[j];
+    }
+    if (!removed && bst_compact_get(bst, TEST_DATA[i]) != &TEST_DATA[i]) {
+      num_missing++;
+    }
+  }
+  printf("  -- original keys missing or wrong: %d (expected 0)\n",
+    num_missing);
+
+  bst_compact_free(bst);
+
+  return 0;
+}
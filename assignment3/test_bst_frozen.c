@@ -0,0 +1,213 @@
+/*
+ * This file contains executable code for testing the frozen BST
+ * implementation.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bst.h"
+#include "bst_frozen.h"
+
+/*
+ * This is the same data used by test_bst.c.
+ */
+#define NUM_TEST_DATA 13
+const int TEST_DATA[NUM_TEST_DATA] =
+  {64, 32, 96, 16, 48, 80, 112, 8, 24, 56, 88, 104, 120};
+
+/*
+ * This is the number of keys in the bigger tree that gets frozen.
+ */
+#define NUM_MANY_KEYS 100000
+
+/*
+ * This is a helper function that's used to compare integers when sorting with
+ * qsort().
+ */
+int cmp_ints(const void* a, const void* b) {
+  return *(int*)a - *(int*)b;
+}
+
+/*
+ * This is the file the save and load tests write to.  It's removed at the end.
+ */
+#define SAVE_FILE "test_bst_frozen.dat"
+
+/*
+ * These functions save an int value to a file and make a new int value from
+ * saved bytes.
+ */
+void write_int(void* value, FILE* file) {
+  fwrite(value, sizeof(int), 1, file);
+}
+
+void* read_int(void* data, size_t size) {
+  int* value = malloc(sizeof(int));
+  memcpy(value, data, size);
+  return value;
+}
+
+int main(int argc, char** argv) {
+  printf("== Creating BST, inserting %d values and freezing it...\n",
+    NUM_TEST_DATA);
+  struct bst* bst = bst_create();
+  for (int i = 0; i < NUM_TEST_DATA; i++) {
+    bst_insert(bst, TEST_DATA[i], (void*)&TEST_DATA[i]);
+  }
+  struct bst_frozen* frozen = bst_freeze(bst);
+
+  /*
+   * Changing the BST afterwards shouldn't change the frozen copy.
+   */
+  bst_remove(bst, TEST_DATA[0]);
+  bst_insert(bst, 1, NULL);
+
+  printf("\n== Checking bst_frozen_size(): %d (expected %d)\n",
+    bst_frozen_size(frozen), NUM_TEST_DATA);
+
+  int* sorted = malloc(NUM_TEST_DATA * sizeof(int));
+  memcpy(sorted, TEST_DATA, NUM_TEST_DATA * sizeof(int));
+  qsort(sorted, NUM_TEST_DATA, sizeof(int), cmp_ints);
+
+  printf("\n== Looking up values we know should be in the frozen BST...\n");
+  for (int i = 0; i < NUM_TEST_DATA; i++) {
+    const int* value = bst_frozen_get(frozen, TEST_DATA[i]);
+    if (value) {
+      printf("  -- bst_frozen_get(%3d): %3d (expected %3d)\n", TEST_DATA[i],
+        *value, TEST_DATA[i]);
+    } else {
+      printf("  -- bst_frozen_get(%3d) unexpectedly returned NULL\n",
+        TEST_DATA[i]);
+    }
+  }
+
+  printf("\n== Looking up values we know should NOT be in the frozen BST...\n");
+  int num_unexpected = 0;
+  for (int i = -5, k = 0; i < sorted[NUM_TEST_DATA - 1] + 5; i++) {
+    if (k < NUM_TEST_DATA && i == sorted[k]) {
+      k++;
+    } else if (bst_frozen_get(frozen, i) != NULL) {
+      num_unexpected++;
+    }
+  }
+  printf("  -- found %d keys we shouldn't have found (expected 0)\n",
+    num_unexpected);
+
+  printf("\n== Iterating over the frozen BST...\n");
+  struct bst_frozen_iterator* iter = bst_frozen_iterator_create(frozen);
+  int i = 0;
+  while (bst_frozen_iterator_has_next(iter)) {
+    int* value = NULL;
+    int key = bst_frozen_iterator_next(iter, (void**)&value);
+    printf("  -- key: %3d, value: %3d (expected key: %3d, value: %3d)\n", key,
+      value ? *value : -1, sorted[i], sorted[i]);
+    i++;
+  }
+  printf("  -- iterated over %d keys (expected %d)\n", i, NUM_TEST_DATA);
+  bst_frozen_iterator_free(iter);
+  bst_frozen_free(frozen);
+
+  /*
+   * Freeze a bigger tree with only the even keys and check every lookup.
+   */
+  printf("\n== Freezing a BST with %d even keys...\n", NUM_MANY_KEYS);
+  bst_free(bst);
+  bst = bst_create();
+  for (i = 0; i < NUM_MANY_KEYS; i++) {
+    bst_insert(bst, 2 * i, (void*)&TEST_DATA[0]);
+  }
+  frozen = bst_freeze(bst);
+  int num_wrong = 0;
+  for (i = -1; i <= 2 * NUM_MANY_KEYS; i++) {
+    if ((bst_frozen_get(frozen, i) != NULL) != (bst_get(bst, i) != NULL)) {
+      num_wrong++;
+    }
+  }
+  printf("  -- lookups that disagree with the BST: %d (expected 0)\n",
+    num_wrong);
+  bst_frozen_free(frozen);
+
+  /*
+   * Save the bigger tree without values, then map it and load it back.
+   */
+  printf("\n== Saving the BST with %d even keys and mapping it...\n",
+    NUM_MANY_KEYS);
+  printf("  -- bst_save(): %d (expected 0)\n", bst_save(bst, SAVE_FILE, NULL));
+  frozen = bst_map(SAVE_FILE);
+  num_wrong = 0;
+  for (i = -1; i <= 2 * NUM_MANY_KEYS; i++) {
+    if ((bst_frozen_get(frozen, i) != NULL) != (bst_get(bst, i) != NULL)) {
+      num_wrong++;
+    }
+  }
+  printf("  -- bst_frozen_size(): %d (expected %d)\n", bst_frozen_size(frozen),
+    NUM_MANY_KEYS);
+  printf("  -- lookups that disagree with the BST: %d (expected 0)\n",
+    num_wrong);
+  bst_frozen_free(frozen);
+
+  struct bst* loaded = bst_load(SAVE_FILE, NULL);
+  printf("  -- bst_load() range sum: %d (expected %d)\n",
+    bst_range_sum(loaded, 0, 2 * NUM_MANY_KEYS),
+    bst_range_sum(bst, 0, 2 * NUM_MANY_KEYS));
+  bst_free(loaded);
+  bst_free(bst);
+
+  /*
+   * Save the small tree with its values and check that they come back.
+   */
+  printf("\n== Saving a BST with %d values and loading it...\n",
+    NUM_TEST_DATA);
+  bst = bst_create();
+  for (i = 0; i < NUM_TEST_DATA; i++) {
+    bst_insert(bst, TEST_DATA[i], (void*)&TEST_DATA[i]);
+  }
+  bst_save(bst, SAVE_FILE, write_int);
+
+  frozen = bst_map(SAVE_FILE);
+  loaded = bst_load(SAVE_FILE, read_int);
+  num_wrong = 0;
+  for (i = 0; i < NUM_TEST_DATA; i++) {
+    int* mapped_value = bst_frozen_get(frozen, TEST_DATA[i]);
+    int* loaded_value = bst_get(loaded, TEST_DATA[i]);
+    if (!mapped_value || *mapped_value != TEST_DATA[i]
+        || !loaded_value || *loaded_value != TEST_DATA[i]) {
+      num_wrong++;
+    }
+  }
+  printf("  -- bst_size() of loaded BST: %d (expected %d)\n",
+    bst_size(loaded), NUM_TEST_DATA);
+  printf("  -- mapped or loaded values that are wrong: %d (expected 0)\n",
+    num_wrong);
+  printf("  -- bst_map() of a missing file returns NULL: %s\n",
+    bst_map("no_such_file.dat") == NULL ? "yes" : "NO");
+
+  for (i = 0; i < NUM_TEST_DATA; i++) {
+    free(bst_get(loaded, TEST_DATA[i]));
+  }
+  bst_free(loaded);
+  bst_frozen_free(frozen);
+
+  /*
+   * Point one value's bytes far past the end of the file.  The header is
+   * still fine, so only checking the offsets catches this.
+   */
+  FILE* file = fopen(SAVE_FILE, "r+b");
+  long long offsets_pos, bad_offset = 1LL << 40;
+  fseek(file, 3 * sizeof(long long), SEEK_SET);
+  fread(&offsets_pos, sizeof(long long), 1, file);
+  fseek(file, offsets_pos + NUM_TEST_DATA * sizeof(long long), SEEK_SET);
+  fwrite(&bad_offset, sizeof(long long), 1, file);
+  fclose(file);
+  printf("  -- bst_map() and bst_load() of a file with a corrupt offset return "
+    "NULL: %s\n", bst_map(SAVE_FILE) == NULL
+    && bst_load(SAVE_FILE, read_int) == NULL ? "yes" : "NO");
+  remove(SAVE_FILE);
+
+  free(sorted);
+  bst_free(bst);
+
+  return 0;
+}
@@ -0,0 +1,182 @@
+/*
+ * This file contains executable code for testing your BST iterator
+ * implementation.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bst.h"
+
+/*
+ * This is the data that's used to test this program.  It forms a tree that
+ * looks like this:
+ *
+ *               64
+ *              /  \
+ *             /    \
+ *            /      \
+ *           /        \
+ *          32        96
+ *         /  \      /  \
+ *        /    \    /    \
+ *       16    48  80    112
+ *      /  \     \   \   /  \
+ *     8   24    56  88 104 120
+ */
+#define NUM_TEST_DATA 13
+const int TEST_DATA[NUM_TEST_DATA] =
+  {64, 32, 96, 16, 48, 80, 112, 8, 24, 56, 88, 104, 120};
+
+/*
+ * This is the number of sequential keys used to check that iteration works on
+ * a bigger tree.
+ */
+#define NUM_SEQUENTIAL_KEYS 100000
+
+/*
+ * These are the bounds of the range of sequential keys iterated over by the
+ * range iterator tests.
+ */
+#define RANGE_LOWER 50000
+#define RANGE_UPPER 50100
+
+/*
+ * This is a helper function that's used to compare integers when sorting with
+ * qsort().
+ */
+int cmp_ints(const void* a, const void* b) {
+  return *(int*)a - *(int*)b;
+}
+
+int main(int argc, char** argv) {
+  /*
+   * Create a new BST and insert the testing data into it.  As in test_bst.c,
+   * each value is the address of the corresponding key.
+   */
+  printf("== Creating BST and inserting %d values...\n", NUM_TEST_DATA);
+  struct bst* bst = bst_create();
+  for (int i = 0; i < NUM_TEST_DATA; i++) {
+    bst_insert(bst, TEST_DATA[i], (void*)&TEST_DATA[i]);
+  }
+
+  /*
+   * Sort a copy of the data, which is the order the iterator should return
+   * the keys in.
+   */
+  int* sorted = malloc(NUM_TEST_DATA * sizeof(int));
+  memcpy(sorted, TEST_DATA, NUM_TEST_DATA * sizeof(int));
+  qsort(sorted, NUM_TEST_DATA, sizeof(int), cmp_ints);
+
+  printf("\n== Iterating over the BST...\n");
+  struct bst_iterator* iter = bst_iterator_create(bst);
+  int i = 0;
+  while (bst_iterator_has_next(iter)) {
+    int* value = NULL;
+    int key = bst_iterator_next(iter, (void**)&value);
+    if (i < NUM_TEST_DATA) {
+      printf("  -- key: %3d, value: %3d (expected key: %3d, value: %3d)\n",
+        key, value ? *value : -1, sorted[i], sorted[i]);
+    } else {
+      printf("  -- key: %3d, but no more keys were expected\n", key);
+    }
+    i++;
+  }
+  printf("  -- iterated over %d keys (expected %d)\n", i, NUM_TEST_DATA);
+  bst_iterator_free(iter);
+
+  /*
+   * Make sure iteration over an empty tree returns nothing.
+   */
+  struct bst* empty = bst_create();
+  iter = bst_iterator_create(empty);
+  printf("\n== Checking iterator over empty BST has no keys: %s\n",
+    bst_iterator_has_next(iter) ? "FAILED" : "OK");
+  bst_iterator_free(iter);
+  bst_free(empty);
+
+  /*
+   * Add a lot of sequential keys and make sure they all come back in order.
+   */
+  printf("\n== Inserting %d sequential keys and iterating...\n",
+    NUM_SEQUENTIAL_KEYS);
+  for (i = 0; i < NUM_SEQUENTIAL_KEYS; i++) {
+    bst_insert(bst, 1000 + i, NULL);
+  }
+  iter = bst_iterator_create(bst);
+  int count = 0, out_of_order = 0, prev = -1;
+  while (bst_iterator_has_next(iter)) {
+    int key = bst_iterator_next(iter, NULL);
+    if (key < prev) {
+      out_of_order++;
+    }
+    prev = key;
+    count++;
+  }
+  bst_iterator_free(iter);
+  printf("  -- iterated over %d keys (expected %d)\n", count,
+    NUM_TEST_DATA + NUM_SEQUENTIAL_KEYS);
+  printf("  -- keys out of order: %d (expected 0)\n", out_of_order);
+
+  /*
+   * Iterate over a range of keys, forwards and backwards, and seek inside it.
+   */
+  printf("\n== Iterating over keys between %d and %d...\n", RANGE_LOWER,
+    RANGE_UPPER);
+  iter = bst_iterator_create_range(bst, RANGE_LOWER, RANGE_UPPER);
+  count = 0;
+  int first = -1, last = -1;
+  while (bst_iterator_has_next(iter)) {
+    last = bst_iterator_next(iter, NULL);
+    if (count == 0) {
+      first = last;
+    }
+    count++;
+  }
+  printf("  -- iterated over %d keys from %d to %d (expected %d keys from %d "
+    "to %d)\n", count, first, last, RANGE_UPPER - RANGE_LOWER + 1,
+    RANGE_LOWER, RANGE_UPPER);
+
+  bst_iterator_seek(iter, RANGE_UPPER - 5);
+  printf("  -- after seeking to %d, next key: %d (expected %d)\n",
+    RANGE_UPPER - 5, bst_iterator_next(iter, NULL), RANGE_UPPER - 5);
+  bst_iterator_seek(iter, 0);
+  printf("  -- after seeking before the range, next key: %d (expected %d)\n",
+    bst_iterator_next(iter, NULL), RANGE_LOWER);
+  bst_iterator_free(iter);
+
+  iter = bst_iterator_create_reverse_range(bst, RANGE_LOWER, RANGE_UPPER);
+  count = 0;
+  while (bst_iterator_has_next(iter)) {
+    last = bst_iterator_next(iter, NULL);
+    if (count == 0) {
+      first = last;
+    }
+    count++;
+  }
+  printf("  -- reverse: iterated over %d keys from %d to %d (expected %d keys "
+    "from %d to %d)\n", count, first, last, RANGE_UPPER - RANGE_LOWER + 1,
+    RANGE_UPPER, RANGE_LOWER);
+  bst_iterator_free(iter);
+
+  /*
+   * Iterate over the small test data in reverse, seeking to a key that isn't
+   * in the tree.
+   */
+  printf("\n== Iterating in reverse from key 100...\n");
+  iter = bst_iterator_create_reverse(bst);
+  bst_iterator_seek(iter, 100);
+  for (i = NUM_TEST_DATA - 4; i >= NUM_TEST_DATA - 7; i--) {
+    int* value = NULL;
+    int key = bst_iterator_next(iter, (void**)&value);
+    printf("  -- key: %3d, value: %3d (expected key: %3d, value: %3d)\n",
+      key, value ? *value : -1, sorted[i], sorted[i]);
+  }
+  bst_iterator_free(iter);
+
+  free(sorted);
+  bst_free(bst);
+
+  return 0;
+}
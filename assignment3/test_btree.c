@@ -0,0 +1,142 @@
+/*
+ * This file contains executable code for testing the B+ tree implementation.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "btree.h"
+
+/*
+ * This is the same data used by test_bst.c.
+ */
+#define NUM_TEST_DATA 13
+const int TEST_DATA[NUM_TEST_DATA] =
+  {64, 32, 96, 16, 48, 80, 112, 8, 24, 56, 88, 104, 120};
+
+#define NUM_RANGE_SUMS 4
+const int RANGE_SUMS[NUM_RANGE_SUMS][3] = {
+  {8, 120, 848},
+  {2, 40, 80},
+  {60, 112, 544},
+  {125, 200, 0}
+};
+
+#define NUM_DATA_TO_REMOVE 4
+const int TEST_DATA_TO_REMOVE[NUM_DATA_TO_REMOVE] = {16, 48, 64, 104};
+
+/*
+ * This is the number of keys inserted and then removed to check that nodes
+ * are split and merged correctly as the tree grows and shrinks.
+ */
+#define NUM_MANY_KEYS 100000
+
+int main(int argc, char** argv) {
+  printf("== Creating B+ tree and inserting %d values...\n", NUM_TEST_DATA);
+  struct btree* btree = btree_create();
+  for (int i = 0; i < NUM_TEST_DATA; i++) {
+    btree_insert(btree, TEST_DATA[i], (void*)&TEST_DATA[i]);
+  }
+
+  printf("\n== Checking btree_size(): %d (expected %d)\n",
+    btree_size(btree), NUM_TEST_DATA);
+
+  printf("\n== Looking up values we know should be in the B+ tree...\n");
+  for (int i = 0; i < NUM_TEST_DATA; i++) {
+    const int* value = btree_get(btree, TEST_DATA[i]);
+    if (value) {
+      printf("  -- btree_get(%3d): %3d (expected %3d)\n", TEST_DATA[i],
+        *value, TEST_DATA[i]);
+    } else {
+      printf("  -- btree_get(%3d) unexpectedly returned NULL\n",
+        TEST_DATA[i]);
+    }
+  }
+
+  printf("\n== Checking range sums in the B+ tree:\n");
+  for (int i = 0; i < NUM_RANGE_SUMS; i++) {
+    printf("  -- btree_range_sum(%d, %d): %d (expected %d)\n",
+      RANGE_SUMS[i][0], RANGE_SUMS[i][1],
+      btree_range_sum(btree, RANGE_SUMS[i][0], RANGE_SUMS[i][1]),
+      RANGE_SUMS[i][2]);
+  }
+
+  printf("\n== Iterating over keys between 20 and 100:");
+  struct btree_iterator* iter = btree_iterator_create_range(btree, 20, 100);
+  while (btree_iterator_has_next(iter)) {
+    printf(" %d", btree_iterator_next(iter, NULL));
+  }
+  printf("\n   (expected 24 32 48 56 64 80 88 96)\n");
+  btree_iterator_free(iter);
+
+  printf("\n== Removing keys from B+ tree...\n");
+  for (int i = 0; i < NUM_DATA_TO_REMOVE; i++) {
+    btree_remove(btree, TEST_DATA_TO_REMOVE[i]);
+    if (btree_get(btree, TEST_DATA_TO_REMOVE[i])) {
+      printf("  -- key %3d still present in B+ tree after removal\n",
+        TEST_DATA_TO_REMOVE[i]);
+    } else {
+      printf("  -- key %3d correctly removed from B+ tree\n",
+        TEST_DATA_TO_REMOVE[i]);
+    }
+  }
+  printf("\n== Checking btree_size(): %d (expected %d)\n",
+    btree_size(btree), NUM_TEST_DATA - NUM_DATA_TO_REMOVE);
+  btree_free(btree);
+
+  /*
+   * Insert many keys in a scrambled order, with every key twice, and then
+   * remove them again, which splits and merges nodes at every level.  The
+   * iterator should see the keys in order with the copies next to each other.
+   */
+  printf("\n== Inserting each of %d keys twice...\n", NUM_MANY_KEYS);
+  btree = btree_create();
+  for (int i = 0; i < NUM_MANY_KEYS; i++) {
+    int key = (int)((i * 7919LL) % NUM_MANY_KEYS);
+    btree_insert(btree, key, (void*)&TEST_DATA[0]);
+    btree_insert(btree, key, (void*)&TEST_DATA[0]);
+  }
+  printf("  -- btree_size(): %d (expected %d)\n", btree_size(btree),
+    2 * NUM_MANY_KEYS);
+
+  int num_out_of_order = 0;
+  int expected = 0;
+  iter = btree_iterator_create(btree);
+  while (btree_iterator_has_next(iter)) {
+    if (btree_iterator_next(iter, NULL) != expected / 2) {
+      num_out_of_order++;
+    }
+    expected++;
+  }
+  btree_iterator_free(iter);
+  printf("  -- keys out of order: %d (expected 0)\n", num_out_of_order);
+
+  printf("\n== Removing one copy of every key, then the odd keys...\n");
+  for (int i = 0; i < NUM_MANY_KEYS; i++) {
+    btree_remove(btree, i);
+  }
+  for (int i = 1; i < NUM_MANY_KEYS; i += 2) {
+    btree_remove(btree, i);
+  }
+  printf("  -- btree_size(): %d (expected %d)\n", btree_size(btree),
+    NUM_MANY_KEYS / 2);
+  int num_wrong = 0;
+  for (int i = 0; i < NUM_MANY_KEYS; i++) {
+    int present = btree_get(btree, i) != NULL;
+    if (present != (i % 2 == 0)) {
+      num_wrong++;
+    }
+  }
+  printf("  -- keys wrongly present or missing: %d (expected 0)\n",
+    num_wrong);
+  long long expected_sum = 0;
+  for (int i = 0; i < 1000; i += 2) {
+    expected_sum += i;
+  }
+  printf("  -- btree_range_sum(0, 999): %d (expected %lld)\n",
+    btree_range_sum(btree, 0, 999), expected_sum);
+
+  btree_free(btree);
+
+  return 0;
+}
@@ -0,0 +1,157 @@
+/*
+ * This file contains executable code for testing the concurrent BST
+ * implementation.  Several writer threads insert and remove keys while reader
+ * threads look keys up and compute range sums at the same time.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#include "cbst.h"
+#include "epoch.h"
+
+#define NUM_WRITERS 4
+#define NUM_READERS 4
+#define KEYS_PER_WRITER 5000
+
+/*
+ * The tree starts out holding the even keys below NUM_STABLE_KEYS, which no
+ * thread removes, so readers can always check them.
+ */
+#define NUM_STABLE_KEYS 2000
+
+/*
+ * These are the values stored in the tree.  Writer w owns the keys
+ * NUM_STABLE_KEYS + w, NUM_STABLE_KEYS + w + NUM_WRITERS, and so on.
+ */
+int values[NUM_STABLE_KEYS + NUM_WRITERS * KEYS_PER_WRITER];
+
+/*
+ * This structure holds the arguments and results of a single thread.
+ */
+struct worker {
+  struct cbst* cbst;
+  int id;
+  int errors;
+};
+
+/*
+ * This is set once every writer has finished, telling the readers to stop.
+ */
+int writers_done = 0;
+
+/*
+ * Each writer inserts all of its keys, checks that it can see them, and then
+ * removes every other one.
+ */
+void* writer(void* arg) {
+  struct worker* w = arg;
+
+  for (int i = NUM_STABLE_KEYS + w->id; i < NUM_STABLE_KEYS + NUM_WRITERS * KEYS_PER_WRITER; i += NUM_WRITERS) {
+    cbst_insert(w->cbst, i, &values[i]);
+  }
+
+  for (int i = NUM_STABLE_KEYS + w->id; i < NUM_STABLE_KEYS + NUM_WRITERS * KEYS_PER_WRITER; i += NUM_WRITERS) {
+    if (cbst_get(w->cbst, i) != &values[i]) {
+      w->errors++;
+    }
+  }
+
+  for (int i = NUM_STABLE_KEYS + w->id; i < NUM_STABLE_KEYS + NUM_WRITERS * KEYS_PER_WRITER; i += 2 * NUM_WRITERS) {
+    cbst_remove(w->cbst, i);
+  }
+
+  return NULL;
+}
+
+/*
+ * Each reader keeps checking the stable keys and their range sum until the
+ * writers are done.  Every snapshot must contain exactly the stable keys below
+ * NUM_STABLE_KEYS.
+ */
+void* reader(void* arg) {
+  struct worker* w = arg;
+  long long expected_sum = 0;
+  for (int i = 0; i < NUM_STABLE_KEYS; i += 2) {
+    expected_sum += i;
+  }
+
+  while (!__atomic_load_n(&writers_done, __ATOMIC_ACQUIRE)) {
+    for (int i = 0; i < NUM_STABLE_KEYS; i++) {
+      void* value = cbst_get(w->cbst, i);
+      if (value != (i % 2 == 0 ? &values[i] : NULL)) {
+        w->errors++;
+      }
+    }
+    if (cbst_range_sum(w->cbst, 0, NUM_STABLE_KEYS - 1) != expected_sum) {
+      w->errors++;
+    }
+  }
+
+  return NULL;
+}
+
+int main(int argc, char** argv) {
+  struct cbst* cbst = cbst_create();
+  pthread_t writers[NUM_WRITERS], readers[NUM_READERS];
+  struct worker writer_args[NUM_WRITERS], reader_args[NUM_READERS];
+
+  for (int i = 0; i < NUM_STABLE_KEYS; i += 2) {
+    cbst_insert(cbst, i, &values[i]);
+  }
+
+  printf("== Running %d writers and %d readers on the same tree...\n",
+    NUM_WRITERS, NUM_READERS);
+  for (int i = 0; i < NUM_READERS; i++) {
+    reader_args[i] = (struct worker){cbst, i, 0};
+    pthread_create(&readers[i], NULL, reader, &reader_args[i]);
+  }
+  for (int i = 0; i < NUM_WRITERS; i++) {
+    writer_args[i] = (struct worker){cbst, i, 0};
+    pthread_create(&writers[i], NULL, writer, &writer_args[i]);
+  }
+
+  int errors = 0;
+  for (int i = 0; i < NUM_WRITERS; i++) {
+    pthread_join(writers[i], NULL);
+    errors += writer_args[i].errors;
+  }
+  __atomic_store_n(&writers_done, 1, __ATOMIC_RELEASE);
+  for (int i = 0; i < NUM_READERS; i++) {
+    pthread_join(readers[i], NULL);
+    errors += reader_args[i].errors;
+  }
+  printf("  -- errors seen by threads: %d (expected 0)\n", errors);
+
+  int expected_size = NUM_STABLE_KEYS / 2 + NUM_WRITERS * KEYS_PER_WRITER / 2;
+  printf("\n== Checking cbst_size(): %d (expected %d)\n", cbst_size(cbst),
+    expected_size);
+
+  /*
+   * The remaining keys are the stable even keys and the keys each writer
+   * didn't remove.  The iterator should see all of them, in increasing order.
+   */
+  printf("\n== Checking keys seen by the iterator...\n");
+  int num_wrong = 0, num_seen = 0, prev = -1;
+  struct cbst_iterator* iter = cbst_iterator_create(cbst);
+  while (cbst_iterator_has_next(iter)) {
+    int key = cbst_iterator_next(iter, NULL);
+    int offset = key - NUM_STABLE_KEYS;
+    int remains = (key < NUM_STABLE_KEYS) ? key % 2 == 0
+      : offset % (2 * NUM_WRITERS) >= NUM_WRITERS;
+    if (key <= prev || !remains) {
+      num_wrong++;
+    }
+    prev = key;
+    num_seen++;
+  }
+  cbst_iterator_free(iter);
+  printf("  -- keys seen: %d (expected %d), wrong keys: %d (expected 0)\n",
+    num_seen, expected_size, num_wrong);
+
+  cbst_free(cbst);
+  epoch_flush();
+
+  return 0;
+}
@@ -0,0 +1,137 @@
+/*
+ * This file contains executable code for testing the persistent BST
+ * implementation.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#include "pbst.h"
+
+/*
+ * This is the same data used by test_bst.c.
+ */
+#define NUM_TEST_DATA 13
+const int TEST_DATA[NUM_TEST_DATA] =
+  {64, 32, 96, 16, 48, 80, 112, 8, 24, 56, 88, 104, 120};
+
+#define NUM_DATA_TO_REMOVE 4
+const int TEST_DATA_TO_REMOVE[NUM_DATA_TO_REMOVE] = {16, 48, 64, 104};
+
+/*
+ * This is the number of keys in the tree a reader thread sums over while the
+ * main thread keeps making new versions of it.
+ */
+#define NUM_SNAPSHOT_KEYS 10000
+#define NUM_SNAPSHOT_SUMS 2000
+
+/*
+ * The reader thread sums every prefix of a snapshot and counts the sums that
+ * don't match what the tree held when the snapshot was taken.
+ */
+void* sum_snapshot(void* arg) {
+  struct pbst* snapshot = arg;
+  long errors = 0;
+
+  for (int i = 0; i < NUM_SNAPSHOT_SUMS; i++) {
+    int upper = i * (NUM_SNAPSHOT_KEYS / NUM_SNAPSHOT_SUMS);
+    if (pbst_range_sum(snapshot, 0, upper) != upper * (upper + 1) / 2) {
+      errors++;
+    }
+  }
+
+  pbst_free(snapshot);
+  return (void*)errors;
+}
+
+int main(int argc, char** argv) {
+  printf("== Building one version per insert for %d values...\n",
+    NUM_TEST_DATA);
+  struct pbst* versions[NUM_TEST_DATA + 1];
+  versions[0] = pbst_create();
+  for (int i = 0; i < NUM_TEST_DATA; i++) {
+    versions[i + 1] = pbst_insert(versions[i], TEST_DATA[i],
+      (void*)&TEST_DATA[i]);
+  }
+
+  printf("\n== Checking that each version holds only the keys inserted before it...\n");
+  int num_wrong = 0;
+  for (int v = 0; v <= NUM_TEST_DATA; v++) {
+    if (pbst_size(versions[v]) != v) {
+      num_wrong++;
+    }
+    for (int i = 0; i < NUM_TEST_DATA; i++) {
+      const int* value = pbst_get(versions[v], TEST_DATA[i]);
+      if (value != (i < v ? &TEST_DATA[i] : NULL)) {
+        num_wrong++;
+      }
+    }
+  }
+  printf("  -- wrong sizes or lookups: %d (expected 0)\n", num_wrong);
+  printf("  -- pbst_range_sum(8, 120) in version 3: %d (expected 192)\n",
+    pbst_range_sum(versions[3], 8, 120));
+  printf("  -- pbst_range_sum(8, 120) in version %d: %d (expected 848)\n",
+    NUM_TEST_DATA, pbst_range_sum(versions[NUM_TEST_DATA], 8, 120));
+
+  printf("\n== Removing keys from the last version...\n");
+  struct pbst* pbst = pbst_snapshot(versions[NUM_TEST_DATA]);
+  for (int i = 0; i < NUM_DATA_TO_REMOVE; i++) {
+    struct pbst* next = pbst_remove(pbst, TEST_DATA_TO_REMOVE[i]);
+    pbst_free(pbst);
+    pbst = next;
+  }
+  printf("  -- pbst_size() after removing: %d (expected %d)\n",
+    pbst_size(pbst), NUM_TEST_DATA - NUM_DATA_TO_REMOVE);
+  printf("  -- pbst_size() of the version removed from: %d (expected %d)\n",
+    pbst_size(versions[NUM_TEST_DATA]), NUM_TEST_DATA);
+  printf("  -- keys after removing:");
+  struct pbst_iterator* iter = pbst_iterator_create(pbst);
+  while (pbst_iterator_has_next(iter)) {
+    printf(" %d", pbst_iterator_next(iter, NULL));
+  }
+  pbst_iterator_free(iter);
+  printf("\n     (expected 8 24 32 56 80 88 96 112 120)\n");
+
+  /*
+   * Free the versions out of order, so nodes are freed by whichever version
+   * happens to drop the last reference to them.
+   */
+  for (int v = 0; v <= NUM_TEST_DATA; v += 2) {
+    pbst_free(versions[v]);
+  }
+  for (int v = 1; v <= NUM_TEST_DATA; v += 2) {
+    pbst_free(versions[v]);
+  }
+  pbst_free(pbst);
+
+  /*
+   * Take a snapshot and sum over it in another thread while this thread
+   * removes every key and inserts them again with different values.
+   */
+  printf("\n== Summing over a snapshot while making new versions...\n");
+  pbst = pbst_create();
+  for (int i = 1; i <= NUM_SNAPSHOT_KEYS; i++) {
+    struct pbst* next = pbst_insert(pbst, i, NULL);
+    pbst_free(pbst);
+    pbst = next;
+  }
+
+  pthread_t reader;
+  pthread_create(&reader, NULL, sum_snapshot, pbst_snapshot(pbst));
+  for (int i = 1; i <= NUM_SNAPSHOT_KEYS; i++) {
+    struct pbst* next = pbst_remove(pbst, i);
+    pbst_free(pbst);
+    pbst = pbst_insert(next, 2 * i, NULL);
+    pbst_free(next);
+  }
+  void* errors;
+  pthread_join(reader, &errors);
+
+  printf("  -- wrong sums in the snapshot: %ld (expected 0)\n", (long)errors);
+  printf("  -- pbst_range_sum(1, 10) in the new version: %d (expected 30)\n",
+    pbst_range_sum(pbst, 1, 10));
+  pbst_free(pbst);
+
+  return 0;
+}
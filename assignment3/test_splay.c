@@ -0,0 +1,104 @@
+/*
+ * This file contains executable code for testing the splay tree
+ * implementation.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "splay.h"
+
+/*
+ * This is the same data used by test_bst.c.
+ */
+#define NUM_TEST_DATA 13
+const int TEST_DATA[NUM_TEST_DATA] =
+  {64, 32, 96, 16, 48, 80, 112, 8, 24, 56, 88, 104, 120};
+
+#define NUM_RANGE_SUMS 4
+const int RANGE_SUMS[NUM_RANGE_SUMS][3] = {
+  {8, 120, 848},
+  {2, 40, 80},
+  {60, 112, 544},
+  {125, 200, 0}
+};
+
+#define NUM_DATA_TO_REMOVE 4
+const int TEST_DATA_TO_REMOVE[NUM_DATA_TO_REMOVE] = {16, 48, 64, 104};
+
+/*
+ * This is the number of sorted keys inserted to build a tree that is one long
+ * path, which the tree must handle without recursing down it.
+ */
+#define NUM_SEQUENTIAL_KEYS 1000000
+
+int main(int argc, char** argv) {
+  printf("== Creating splay tree and inserting %d values...\n", NUM_TEST_DATA);
+  struct splay* splay = splay_create();
+  for (int i = 0; i < NUM_TEST_DATA; i++) {
+    splay_insert(splay, TEST_DATA[i], (void*)&TEST_DATA[i]);
+  }
+
+  printf("\n== Checking splay_size(): %d (expected %d)\n",
+    splay_size(splay), NUM_TEST_DATA);
+
+  printf("\n== Looking up values we know should be in the splay tree...\n");
+  for (int i = 0; i < NUM_TEST_DATA; i++) {
+    const int* value = splay_get(splay, TEST_DATA[i]);
+    if (value) {
+      printf("  -- splay_get(%3d): %3d (expected %3d)\n", TEST_DATA[i],
+        *value, TEST_DATA[i]);
+    } else {
+      printf("  -- splay_get(%3d) unexpectedly returned NULL\n",
+        TEST_DATA[i]);
+    }
+  }
+
+  printf("\n== Checking range sums in the splay tree:\n");
+  for (int i = 0; i < NUM_RANGE_SUMS; i++) {
+    printf("  -- splay_range_sum(%d, %d): %d (expected %d)\n",
+      RANGE_SUMS[i][0], RANGE_SUMS[i][1],
+      splay_range_sum(splay, RANGE_SUMS[i][0], RANGE_SUMS[i][1]),
+      RANGE_SUMS[i][2]);
+  }
+
+  printf("\n== Removing keys from splay tree...\n");
+  for (int i = 0; i < NUM_DATA_TO_REMOVE; i++) {
+    splay_remove(splay, TEST_DATA_TO_REMOVE[i]);
+    if (splay_get(splay, TEST_DATA_TO_REMOVE[i])) {
+      printf("  -- key %3d still present in splay tree after removal\n",
+        TEST_DATA_TO_REMOVE[i]);
+    } else {
+      printf("  -- key %3d correctly removed from splay tree\n",
+        TEST_DATA_TO_REMOVE[i]);
+    }
+  }
+  printf("\n== Checking splay_size(): %d (expected %d)\n",
+    splay_size(splay), NUM_TEST_DATA - NUM_DATA_TO_REMOVE);
+  printf("  -- splay_range_sum(8, 120): %d (expected %d)\n",
+    splay_range_sum(splay, 8, 120), 848 - 16 - 48 - 64 - 104);
+  splay_free(splay);
+
+  /*
+   * Sorted inserts leave the tree as one long path.  Looking the keys up in
+   * order then walks down that path, and freeing the tree must not recurse.
+   */
+  printf("\n== Inserting %d sorted keys and looking them up...\n",
+    NUM_SEQUENTIAL_KEYS);
+  splay = splay_create();
+  for (int i = 0; i < NUM_SEQUENTIAL_KEYS; i++) {
+    splay_insert(splay, i, (void*)&TEST_DATA[0]);
+  }
+  int num_missing = 0;
+  for (int i = 0; i < NUM_SEQUENTIAL_KEYS; i++) {
+    if (splay_get(splay, i) == NULL) {
+      num_missing++;
+    }
+  }
+  printf("  -- keys missing: %d (expected 0)\n", num_missing);
+  printf("  -- splay_range_sum(0, 999): %d (expected %d)\n",
+    splay_range_sum(splay, 0, 999), 999 * 1000 / 2);
+  splay_free(splay);
+
+  return 0;
+}
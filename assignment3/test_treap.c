@@ -0,0 +1,153 @@
+/*
+ * This file contains executable code for testing the treap implementation.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "treap.h"
+
+/*
+ * This is the same data used by test_bst.c.
+ */
+#define NUM_TEST_DATA 13
+const int TEST_DATA[NUM_TEST_DATA] =
+  {64, 32, 96, 16, 48, 80, 112, 8, 24, 56, 88, 104, 120};
+
+#define NUM_DATA_TO_REMOVE 4
+const int TEST_DATA_TO_REMOVE[NUM_DATA_TO_REMOVE] = {16, 48, 64, 104};
+
+/*
+ * The set operations are tested on the multiples of 2 and the multiples of 3
+ * below NUM_SET_KEYS, with one thread and then with several.
+ */
+#define NUM_SET_KEYS 300000
+#define NUM_THREADS 4
+
+/*
+ * These are the values stored with the keys of the two sets, so the tests can
+ * tell which set a value came from.
+ */
+int from_a = 1, from_b = 2;
+
+/*
+ * This function builds a treap of the multiples of `step` below
+ * NUM_SET_KEYS, all with the value `value`.
+ */
+struct treap* multiples(int step, int* value) {
+  struct treap* treap = treap_create();
+  for (int i = 0; i < NUM_SET_KEYS; i += step) {
+    treap_insert(treap, i, value);
+  }
+  return treap;
+}
+
+/*
+ * This function counts the keys below NUM_SET_KEYS that a treap gets wrong.
+ * `expected` returns the value a key should have in the treap, or NULL if it
+ * shouldn't be there at all.  A wrong size also counts as one wrong key.
+ */
+int count_wrong(struct treap* treap, int* (*expected)(int key)) {
+  int num_wrong = 0, num_expected = 0;
+  for (int i = 0; i < NUM_SET_KEYS; i++) {
+    if (expected(i) != NULL) {
+      num_expected++;
+    }
+    if (treap_get(treap, i) != expected(i)) {
+      num_wrong++;
+    }
+  }
+  if (treap_size(treap) != num_expected) {
+    num_wrong++;
+  }
+  return num_wrong;
+}
+
+/*
+ * These functions give the expected value of a key in the union of a and b,
+ * the intersection of b and a (which keeps b's values) and the difference of
+ * a and b.
+ */
+int* union_value(int key) {
+  return key % 2 == 0 ? &from_a : key % 3 == 0 ? &from_b : NULL;
+}
+
+int* intersection_value(int key) {
+  return key % 6 == 0 ? &from_b : NULL;
+}
+
+int* difference_value(int key) {
+  return key % 2 == 0 && key % 3 != 0 ? &from_a : NULL;
+}
+
+int main(int argc, char** argv) {
+  printf("== Creating treap and inserting %d values...\n", NUM_TEST_DATA);
+  struct treap* treap = treap_create();
+  for (int i = 0; i < NUM_TEST_DATA; i++) {
+    treap_insert(treap, TEST_DATA[i], (void*)&TEST_DATA[i]);
+  }
+  treap_insert(treap, TEST_DATA[0], (void*)&TEST_DATA[0]);
+  printf("\n== Checking treap_size() after inserting one key twice: %d "
+    "(expected %d)\n", treap_size(treap), NUM_TEST_DATA);
+
+  printf("\n== Looking up values we know should be in the treap...\n");
+  for (int i = 0; i < NUM_TEST_DATA; i++) {
+    const int* value = treap_get(treap, TEST_DATA[i]);
+    if (value) {
+      printf("  -- treap_get(%3d): %3d (expected %3d)\n", TEST_DATA[i],
+        *value, TEST_DATA[i]);
+    } else {
+      printf("  -- treap_get(%3d) unexpectedly returned NULL\n",
+        TEST_DATA[i]);
+    }
+  }
+
+  printf("\n== Removing keys from treap...\n");
+  for (int i = 0; i < NUM_DATA_TO_REMOVE; i++) {
+    treap_remove(treap, TEST_DATA_TO_REMOVE[i]);
+    if (treap_get(treap, TEST_DATA_TO_REMOVE[i])) {
+      printf("  -- key %3d still present in treap after removal\n",
+        TEST_DATA_TO_REMOVE[i]);
+    } else {
+      printf("  -- key %3d correctly removed from treap\n",
+        TEST_DATA_TO_REMOVE[i]);
+    }
+  }
+
+  printf("\n== Splitting the treap at 80 and joining it back...\n");
+  struct treap* lower;
+  struct treap* upper;
+  treap_split(treap, 80, &lower, &upper);
+  printf("  -- sizes: %d and %d (expected 4 and 5)\n", treap_size(lower),
+    treap_size(upper));
+  printf("  -- treap_get(80) in the upper half: %s (expected yes)\n",
+    treap_get(upper, 80) ? "yes" : "no");
+  treap = treap_join(lower, upper);
+  printf("  -- size after joining: %d (expected %d)\n", treap_size(treap),
+    NUM_TEST_DATA - NUM_DATA_TO_REMOVE);
+  treap_free(treap);
+
+  for (int threads = 1; threads <= NUM_THREADS; threads += NUM_THREADS - 1) {
+    printf("\n== Set operations on multiples of 2 (a) and 3 (b) below %d, "
+      "%d thread(s)...\n", NUM_SET_KEYS, threads);
+
+    treap = treap_union(multiples(2, &from_a), multiples(3, &from_b), threads);
+    printf("  -- union: %d wrong keys (expected 0)\n",
+      count_wrong(treap, union_value));
+    treap_free(treap);
+
+    treap = treap_intersection(multiples(3, &from_b), multiples(2, &from_a),
+      threads);
+    printf("  -- intersection: %d wrong keys (expected 0)\n",
+      count_wrong(treap, intersection_value));
+    treap_free(treap);
+
+    treap = treap_difference(multiples(2, &from_a), multiples(3, &from_b),
+      threads);
+    printf("  -- difference: %d wrong keys (expected 0)\n",
+      count_wrong(treap, difference_value));
+    treap_free(treap);
+  }
+
+  return 0;
+}
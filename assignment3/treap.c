@@ -0,0 +1,534 @@
+/*
+ * This file contains the implementation of a treap.  Each node has a
+ * priority as well as a key; the nodes are in BST order by key and in heap
+ * order by priority (a parent's priority is never lower than its children's).
+ * With priorities that look random, the tree has O(log n) expected height.
+ *
+ * Unlike the other trees, a treap holds each key at most once, like a set.
+ * What makes it useful is that two treaps can be split and joined in
+ * O(log n) time, which gives union, intersection and difference of treaps of
+ * sizes m <= n in O(m log(n/m + 1)) expected time, instead of the O(m log n)
+ * it takes to insert elements one at a time.  These set operations recurse on
+ * independent subtrees, so the top few levels run in parallel on separate
+ * threads.
+ *
+ * A node's priority is a hash of its key, so the shape of a treap depends only
+ * on the keys in it, and no random number generator has to be shared between
+ * threads.
+ *
+ * Name: Gabriel de Leon
+ * Email: deleong@oregonstate.edu
+ */
+
+#include <stdlib.h>
+#include <pthread.h>
+
+#include "treap.h"
+
+/*
+ * This is the smallest number of nodes a set operation must involve before
+ * it's worth handing half of it to another thread.
+ */
+#define PARALLEL_CUTOFF 10000
+
+/*
+ * This structure represents a single node in a treap.  `size` is the number
+ * of nodes in the subtree rooted at the node.
+ */
+struct treap_node {
+  int key;
+  unsigned int priority;
+  int size;
+  void* value;
+  struct treap_node* left;
+  struct treap_node* right;
+};
+
+/*
+ * This structure represents an entire treap.
+ */
+struct treap {
+  struct treap_node* root;
+};
+
+/*
+ * These are the set operations that set_op() can do.
+ */
+enum set_op_type {
+  SET_UNION,
+  SET_INTERSECTION,
+  SET_DIFFERENCE
+};
+
+/*
+ * This structure holds the inputs of one set operation on two subtrees, which
+ * may run on its own thread, along with the resulting subtree.  `a_first` is 1
+ * if `a` comes from the first treap passed in by the caller, whose values are
+ * kept when both treaps hold a key.
+ */
+struct set_task {
+  enum set_op_type op;
+  struct treap_node* a;
+  struct treap_node* b;
+  int a_first;
+  int threads;
+  struct treap_node* result;
+};
+
+/*
+ * This function returns the priority of a key: a hash that mixes its bits so
+ * nearby keys get unrelated priorities.
+ */
+static unsigned int key_priority(int key) {
+  unsigned int x = (unsigned int)key;
+  x ^= x >> 16;
+  x *= 0x7feb352dU;
+  x ^= x >> 15;
+  x *= 0x846ca68bU;
+  x ^= x >> 16;
+  return x;
+}
+
+/*
+ * This function returns the number of nodes in a subtree, treating an empty
+ * subtree as having size 0.
+ */
+static int node_size(struct treap_node* node) {
+  return node ? node->size : 0;
+}
+
+/*
+ * This function recomputes a node's subtree size from its children.
+ */
+static void node_update(struct treap_node* node) {
+  node->size = node_size(node->left) + node_size(node->right) + 1;
+}
+
+/*
+ * This function frees a node and all of its descendants.
+ */
+static void node_free(struct treap_node* node) {
+  if(node != NULL) {
+    node_free(node->left);
+    node_free(node->right);
+    free(node);
+  }
+}
+
+/*
+ * This function splits the subtree rooted at `node` into the nodes with keys
+ * less than `key` (stored in `lower`) and greater than `key` (stored in
+ * `upper`).  A node holding `key` itself is stored in `equal`, with no
+ * children, or `equal` is set to NULL if there isn't one.
+ */
+static void split(struct treap_node* node, int key, struct treap_node** lower,
+    struct treap_node** upper, struct treap_node** equal) {
+
+  if(node == NULL) {
+    *lower = NULL;
+    *upper = NULL;
+    *equal = NULL;
+  }
+
+  else if(key == node->key) {
+    *lower = node->left;
+    *upper = node->right;
+    node->left = NULL;
+    node->right = NULL;
+    node_update(node);
+    *equal = node;
+  }
+
+  else if(key < node->key) {
+    split(node->left, key, lower, &node->left, equal);
+    node_update(node);
+    *upper = node;
+  }
+
+  else {
+    split(node->right, key, &node->right, upper, equal);
+    node_update(node);
+    *lower = node;
+  }
+}
+
+/*
+ * This function joins two subtrees where every key in `lower` is less than
+ * every key in `upper`, and returns the root of the result.
+ */
+static struct treap_node* join(struct treap_node* lower, struct treap_node* upper) {
+
+  if(lower == NULL) {
+    return upper;
+  }
+  if(upper == NULL) {
+    return lower;
+  }
+
+  //the root with the higher priority stays on top
+  if(lower->priority >= upper->priority) {
+    lower->right = join(lower->right, upper);
+    node_update(lower);
+    return lower;
+  }
+
+  upper->left = join(lower, upper->left);
+  node_update(upper);
+  return upper;
+}
+
+/*
+ * This function does a set operation on the subtrees `task->a` and
+ * `task->b`, using up both of them, and stores the root of the result in
+ * `task->result`.  It splits `b` around the root of `a`, does the operation on
+ * the two halves, and puts the halves back together under `a`'s root (or
+ * without it).  While there is more than one thread to spare, the lower
+ * halves are handled on a new thread.  It is passed a `struct set_task`.
+ */
+static void* set_op(void* arg) {
+
+  struct set_task* task = arg;
+  struct treap_node* a = task->a;
+  struct treap_node* b = task->b;
+  int a_first = task->a_first;
+
+  //one side is empty
+  if(a == NULL || b == NULL) {
+    if(task->op == SET_UNION) {
+      task->result = (a != NULL) ? a : b;
+    }
+    else if(task->op == SET_DIFFERENCE) {
+      task->result = a;
+      node_free(b);
+    }
+    else {
+      task->result = NULL;
+      node_free(a);
+      node_free(b);
+    }
+    return NULL;
+  }
+
+  //a union or intersection keeps the higher-priority root on top, which may
+  //be from either side; a difference always keeps only nodes from `a`
+  if(task->op != SET_DIFFERENCE && b->priority > a->priority) {
+    struct treap_node* temp = a;
+    a = b;
+    b = temp;
+    a_first = !a_first;
+  }
+
+  struct treap_node* b_lower;
+  struct treap_node* b_upper;
+  struct treap_node* equal;
+  split(b, a->key, &b_lower, &b_upper, &equal);
+
+  struct set_task lower = {task->op, a->left, b_lower, a_first, task->threads / 2, NULL};
+  struct set_task upper = {task->op, a->right, b_upper, a_first, task->threads - task->threads / 2, NULL};
+
+  //handles the lower halves on another thread if it's worth it
+  pthread_t thread;
+  int spawned = 0;
+  if(task->threads > 1 && node_size(a) + node_size(b) >= PARALLEL_CUTOFF) {
+    spawned = pthread_create(&thread, NULL, set_op, &lower) == 0;
+  }
+  if(!spawned) {
+    lower.threads = 1;
+    upper.threads = 1;
+    set_op(&lower);
+  }
+  set_op(&upper);
+  if(spawned) {
+    pthread_join(thread, NULL);
+  }
+
+  //decides whether `a`'s root belongs in the result
+  int keep = (task->op == SET_UNION) || ((task->op == SET_INTERSECTION) == (equal != NULL));
+  if(equal != NULL) {
+    if(keep && !a_first) {
+      a->value = equal->value;
+    }
+    free(equal);
+  }
+
+  if(!keep) {
+    free(a);
+    task->result = join(lower.result, upper.result);
+    return NULL;
+  }
+
+  a->left = lower.result;
+  a->right = upper.result;
+  node_update(a);
+  task->result = a;
+
+  return NULL;
+}
+
+/*
+ * This function runs a set operation on two treaps, using both of them up,
+ * and returns a treap holding the result.
+ */
+static struct treap* run_set_op(enum set_op_type op, struct treap* a, struct treap* b, int threads) {
+
+  struct set_task task = {op, a->root, b->root, 1, threads, NULL};
+  set_op(&task);
+
+  a->root = task.result;
+  free(b);
+
+  return a;
+}
+
+/*
+ * This function inserts `node` into the subtree rooted at `root`, which must
+ * not already hold its key, and returns the new root of the subtree.
+ */
+static struct treap_node* insert(struct treap_node* root, struct treap_node* node) {
+
+  //the new node goes here if it outranks everything below
+  if(root == NULL || node->priority > root->priority) {
+    struct treap_node* equal;
+    split(root, node->key, &node->left, &node->right, &equal);
+    node_update(node);
+    return node;
+  }
+
+  if(node->key < root->key) {
+    root->left = insert(root->left, node);
+  }
+  else {
+    root->right = insert(root->right, node);
+  }
+  node_update(root);
+
+  return root;
+}
+
+/*
+ * This function removes the node holding `key` from the subtree rooted at
+ * `root` (if there is one), and returns the new root of the subtree.
+ */
+static struct treap_node* remove_key(struct treap_node* root, int key) {
+
+  if(root == NULL) {
+    return NULL;
+  }
+
+  if(key == root->key) {
+    struct treap_node* result = join(root->left, root->right);
+    free(root);
+    return result;
+  }
+
+  if(key < root->key) {
+    root->left = remove_key(root->left, key);
+  }
+  else {
+    root->right = remove_key(root->right, key);
+  }
+  node_update(root);
+
+  return root;
+}
+
+/*
+ * This function should allocate and initialize a new, empty treap and return
+ * a pointer to it.
+ */
+struct treap* treap_create() {
+  struct treap* treap = malloc(sizeof(struct treap));
+  treap->root = NULL;
+  return treap;
+}
+
+/*
+ * This function frees the memory associated with a treap.  It does not free
+ * the values stored in the treap.
+ *
+ * Params:
+ *   treap - the treap to be destroyed.  May not be NULL.
+ */
+void treap_free(struct treap* treap) {
+  node_free(treap->root);
+  free(treap);
+}
+
+/*
+ * This function returns the number of keys in a treap.  Takes O(1) time.
+ *
+ * Params:
+ *   treap - the treap whose keys are to be counted.  May not be NULL.
+ */
+int treap_size(struct treap* treap) {
+  return node_size(treap->root);
+}
+
+/*
+ * This function inserts a key/value pair into a treap.  If the key is already
+ * in the treap, its value is replaced instead.  Takes O(log n) expected time.
+ *
+ * Params:
+ *   treap - the treap into which to insert.  May not be NULL.
+ *   key - the key used to order the key/value pair.
+ *   value - the value to store with the key.
+ */
+void treap_insert(struct treap* treap, int key, void* value) {
+
+  struct treap_node* node = treap->root;
+  while(node != NULL) {
+    if(key == node->key) {
+      node->value = value;
+      return;
+    }
+    node = (key < node->key) ? node->left : node->right;
+  }
+
+  node = malloc(sizeof(struct treap_node));
+  node->key = key;
+  node->priority = key_priority(key);
+  node->value = value;
+  node->left = NULL;
+  node->right = NULL;
+
+  treap->root = insert(treap->root, node);
+}
+
+/*
+ * This function removes a key and its value from a treap.  If the key isn't
+ * in the treap, nothing happens.  Takes O(log n) expected time.
+ *
+ * Params:
+ *   treap - the treap from which to remove.  May not be NULL.
+ *   key - the key to remove.
+ */
+void treap_remove(struct treap* treap, int key) {
+  treap->root = remove_key(treap->root, key);
+}
+
+/*
+ * This function returns the value associated with a key in a treap.  Takes
+ * O(log n) expected time.
+ *
+ * Params:
+ *   treap - the treap to search.  May not be NULL.
+ *   key - the key whose value is to be returned.
+ *
+ * Return:
+ *   Should return the value associated with `key`, or NULL if `key` isn't in
+ *   the treap.
+ */
+void* treap_get(struct treap* treap, int key) {
+
+  struct treap_node* node = treap->root;
+  while(node != NULL) {
+    if(key == node->key) {
+      return node->value;
+    }
+    node = (key < node->key) ? node->left : node->right;
+  }
+
+  return NULL;
+}
+
+/*
+ * This function splits a treap into the keys less than `key` and the keys
+ * greater than or equal to `key`.  `treap` is used up and must not be used
+ * again.  Takes O(log n) expected time.
+ *
+ * Params:
+ *   treap - the treap to split.  May not be NULL.
+ *   key - the key to split at.
+ *   lower - pointer at which to store a new treap of the keys less than `key`.
+ *   upper - pointer at which to store a new treap of the rest of the keys.
+ */
+void treap_split(struct treap* treap, int key, struct treap** lower, struct treap** upper) {
+
+  struct treap_node* equal;
+  *lower = treap_create();
+  *upper = treap_create();
+  split(treap->root, key, &(*lower)->root, &(*upper)->root, &equal);
+
+  //the node holding `key`, if any, goes back into the upper half
+  if(equal != NULL) {
+    (*upper)->root = insert((*upper)->root, equal);
+  }
+
+  free(treap);
+}
+
+/*
+ * This function joins two treaps where every key in `lower` is less than
+ * every key in `upper` into one treap.  Both treaps are used up and must not
+ * be used again.  Takes O(log n) expected time.
+ *
+ * Params:
+ *   lower - the treap with the smaller keys.  May not be NULL.
+ *   upper - the treap with the larger keys.  May not be NULL.
+ *
+ * Return:
+ *   Should return a treap holding the keys of both treaps.
+ */
+struct treap* treap_join(struct treap* lower, struct treap* upper) {
+  lower->root = join(lower->root, upper->root);
+  free(upper);
+  return lower;
+}
+
+/*
+ * This function returns the union of two treaps: every key that is in either
+ * of them.  When both treaps hold a key, the value from `a` is kept and the
+ * value from `b` is dropped (but not freed).  Both treaps are used up and must
+ * not be used again.  Takes O(m log(n/m + 1)) expected time, where m and n are
+ * the sizes of the smaller and larger treaps.
+ *
+ * Params:
+ *   a - the first treap.  May not be NULL.
+ *   b - the second treap.  May not be NULL.
+ *   threads - the largest number of threads to use.  1 runs on the calling
+ *     thread only.
+ *
+ * Return:
+ *   Should return a treap holding the union.
+ */
+struct treap* treap_union(struct treap* a, struct treap* b, int threads) {
+  return run_set_op(SET_UNION, a, b, threads);
+}
+
+/*
+ * This function returns the intersection of two treaps: every key that is in
+ * both of them, with its value from `a`.  Both treaps are used up and must not
+ * be used again, and values that don't make it into the result aren't freed.
+ * Takes O(m log(n/m + 1)) expected time.
+ *
+ * Params:
+ *   a - the first treap.  May not be NULL.
+ *   b - the second treap.  May not be NULL.
+ *   threads - the largest number of threads to use.  1 runs on the calling
+ *     thread only.
+ *
+ * Return:
+ *   Should return a treap holding the intersection.
+ */
+struct treap* treap_intersection(struct treap* a, struct treap* b, int threads) {
+  return run_set_op(SET_INTERSECTION, a, b, threads);
+}
+
+/*
+ * This function returns the difference of two treaps: every key in `a` that
+ * isn't in `b`.  Both treaps are used up and must not be used again, and
+ * values that don't make it into the result aren't freed.  Takes
+ * O(m log(n/m + 1)) expected time.
+ *
+ * Params:
+ *   a - the treap to take keys from.  May not be NULL.
+ *   b - the treap of keys to leave out.  May not be NULL.
+ *   threads - the largest number of threads to use.  1 runs on the calling
+ *     thread only.
+ *
+ * Return:
+ *   Should return a treap holding the difference.
+ */
+struct treap* treap_difference(struct treap* a, struct treap* b, int threads) {
+  return run_set_op(SET_DIFFERENCE, a, b, threads);
+}
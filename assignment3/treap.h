@@ -0,0 +1,33 @@
+/*
+ * This file contains the definition of the interface for a treap, a balanced
+ * BST that supports splitting, joining and fast bulk set operations.  You can
+ * find descriptions of the treap functions, including their parameters and
+ * their return values, in treap.c.
+ */
+
+#ifndef __TREAP_H
+#define __TREAP_H
+
+/*
+ * Structure used to represent a treap.
+ */
+struct treap;
+
+/*
+ * Treap interface function prototypes.  Refer to treap.c for documentation
+ * about each of these functions.
+ */
+struct treap* treap_create();
+void treap_free(struct treap* treap);
+int treap_size(struct treap* treap);
+void treap_insert(struct treap* treap, int key, void* value);
+void treap_remove(struct treap* treap, int key);
+void* treap_get(struct treap* treap, int key);
+
+void treap_split(struct treap* treap, int key, struct treap** lower, struct treap** upper);
+struct treap* treap_join(struct treap* lower, struct treap* upper);
+struct treap* treap_union(struct treap* a, struct treap* b, int threads);
+struct treap* treap_intersection(struct treap* a, struct treap* b, int threads);
+struct treap* treap_difference(struct treap* a, struct treap* b, int threads);
+
+#endif
@@ -0,0 +1,137 @@
+/*
+ * This file contains executable code for benchmarking the priority queue
+ * against the dynarray-based implementation it replaced.  The old one
+ * appended each new element and then called dynarray_heapify(), which scans
+ * every internal node and starts over after each swap, and it ordered
+ * elements by dereferencing their values as ints instead of by priority.  A
+ * copy of it is kept here, prefixed with old_pq_, so the two can be timed on
+ * the same sequence of operations.  Values here point to their own
+ * priorities so both implementations put elements in the same order.
+ *
+ * Usage: ./bench_pq [number of elements]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "pq.h"
+#include "dynarray.h"
+
+#define DEFAULT_NUM_ELEMS 10000
+
+/*
+ * This is the old priority queue, with the same logic under a new name.
+ */
+struct old_pq {
+  struct dynarray* arr;
+  int priority;
+};
+
+struct old_pq* old_pq_create() {
+  struct old_pq* pq = malloc(sizeof(struct old_pq));
+  pq->arr = dynarray_create();
+  pq->priority = 100;
+  return pq;
+}
+
+void old_pq_free(struct old_pq* pq) {
+  dynarray_free(pq->arr);
+  free(pq);
+}
+
+int old_pq_isempty(struct old_pq* pq) {
+  return dynarray_size(pq->arr) == 0;
+}
+
+void old_pq_insert(struct old_pq* pq, void* value, int priority) {
+  if (priority < pq->priority || old_pq_isempty(pq)) {
+    pq->priority = priority;
+  }
+  dynarray_insert(pq->arr, value);
+  dynarray_heapify(pq->arr);
+}
+
+void* old_pq_remove_first(struct old_pq* pq) {
+  if (old_pq_isempty(pq)) {
+    return NULL;
+  }
+  void* returned = dynarray_get(pq->arr, 0);
+  void* removed = dynarray_get(pq->arr, dynarray_size(pq->arr) - 1);
+  dynarray_remove(pq->arr, dynarray_size(pq->arr) - 1);
+  if (dynarray_size(pq->arr) == 0) {
+    pq->priority = 0;
+    return returned;
+  }
+  dynarray_set(pq->arr, 0, removed);
+  dynarray_heapify(pq->arr);
+  pq->priority = *(int*)dynarray_get(pq->arr, 0);
+  return returned;
+}
+
+/*
+ * This function returns the number of seconds since `start`.
+ */
+double seconds_since(clock_t start) {
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+int main(int argc, char** argv) {
+  int n = DEFAULT_NUM_ELEMS;
+  if (argc > 1) {
+    n = atoi(argv[1]);
+  }
+
+  int* vals = malloc(n * sizeof(int));
+  srand(0);
+  for (int i = 0; i < n; i++) {
+    vals[i] = rand();
+  }
+
+  printf("== Benchmarking priority queues with %d elements...\n", n);
+
+  /*
+   * Each queue gets every element inserted and then removed in order.  A
+   * running count of out-of-order removals checks that both are correct.
+   */
+  struct pq* pq = pq_create();
+  int out_of_order = 0, last = -1;
+  clock_t start = clock();
+  for (int i = 0; i < n; i++) {
+    pq_insert(pq, &vals[i], vals[i]);
+  }
+  double insert_time = seconds_since(start);
+  start = clock();
+  while (!pq_isempty(pq)) {
+    int val = *(int*)pq_remove_first(pq);
+    out_of_order += val < last;
+    last = val;
+  }
+  double remove_time = seconds_since(start);
+  pq_free(pq);
+  printf("  binary heap    insert: %8.3fs  remove_first: %8.3fs  "
+    "out of order: %d\n", insert_time, remove_time, out_of_order);
+
+  struct old_pq* old_pq = old_pq_create();
+  out_of_order = 0;
+  last = -1;
+  start = clock();
+  for (int i = 0; i < n; i++) {
+    old_pq_insert(old_pq, &vals[i], vals[i]);
+  }
+  insert_time = seconds_since(start);
+  start = clock();
+  while (!old_pq_isempty(old_pq)) {
+    int val = *(int*)old_pq_remove_first(old_pq);
+    out_of_order += val < last;
+    last = val;
+  }
+  remove_time = seconds_since(start);
+  old_pq_free(old_pq);
+  printf("  old heapify    insert: %8.3fs  remove_first: %8.3fs  "
+    "out of order: %d\n", insert_time, remove_time, out_of_order);
+
+  free(vals);
+
+  return 0;
+}
@@ -51,53 +51,54 @@ int main(int argc, char const *argv[]) {
 	//array that holds the distance of the path
 	struct path* paths[n_nodes];
 
+	//handle of each node's entry in the priority queue, or -1 if the node
+	//hasn't been added yet
+	int handles[n_nodes];
+
+	//keeps track of which nodes already have their shortest path
+	int done[n_nodes];
+
 	//initalizes values 
 	for(int i = 0; i < n_nodes; i++) {
 		paths[i] = malloc(sizeof(struct path));
 		paths[i]->node = i;
 		paths[i]->cost = 9999; 
 		paths[i]->prev = NULL;
+		handles[i] = -1;
+		done[i] = 0;
 	}
 	
 	//create priority queue and add first node 
 	struct pq* Q = pq_create();
-	struct path* start = malloc(sizeof(struct path));
-	start->node = START_NODE;
-	start->prev = NULL;
-	start->cost = 0;
-	pq_insert(Q, start, 0);
+	paths[START_NODE]->cost = 0;
+	handles[START_NODE] = pq_insert(Q, paths[START_NODE], 0);
 
 
-	//Dijkstra's algorithm
+	//Dijkstra's algorithm; each node is in the queue at most once, and finding
+	//a cheaper path to a node lowers its priority in place
 	while(!pq_isempty(Q)) {
-		struct path* curr = pq_first(Q);
-		pq_remove_first(Q);
-
-		//if the path hasn't been traversed yet
-		if(paths[curr->node]->cost == 9999) {
-			
-			struct path* temp = paths[curr->node];
-			paths[curr->node] = curr;
-			free(temp);
-
-			//explore all the neighbors of the current node
-			for(int i = 0; i < n_nodes; i++) {
-				if(arr[curr->node][i] != 0) {
-					int total_cost = curr->cost + arr[curr->node][i];
-
-					struct path* next = malloc(sizeof(struct path));
-					next->node = i;
-					next->prev = curr;
-					next->cost = total_cost;
-
-					//insert neighbor into priority queue
-					pq_insert(Q, next, total_cost);
+		struct path* curr = pq_remove_first(Q);
+		done[curr->node] = 1;
+
+		//explore all the neighbors of the current node
+		for(int i = 0; i < n_nodes; i++) {
+			if(arr[curr->node][i] != 0 && !done[i]) {
+				int total_cost = curr->cost + arr[curr->node][i];
+
+				if(total_cost < paths[i]->cost) {
+					paths[i]->cost = total_cost;
+					paths[i]->prev = curr;
+
+					//insert neighbor into priority queue, or move it up if it's
+					//already there
+					if(handles[i] == -1) {
+						handles[i] = pq_insert(Q, paths[i], total_cost);
+					}
+					else {
+						pq_decrease_priority(Q, handles[i], total_cost);
+					}
 				}
 			}
-		}	
-		//shortest path was already found
-		else {
-			free(curr);
 		}
 	}
 
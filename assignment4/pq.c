@@ -11,17 +11,45 @@
 #include <stdlib.h>
 
 #include "pq.h"
-#include "dynarray.h"
 
 /*
- * This is the structure that represents a priority queue.  You must define
- * this struct to contain the data needed to implement a priority queue.
+ * This is the starting capacity of the array that holds the heap.
  */
-struct pq {
-	struct dynarray* arr;
+#define PQ_INIT_CAPACITY 16
+
+/*
+ * This is the structure that represents one element in the heap.  The
+ * priority is stored right next to the value so comparing two elements
+ * doesn't need to follow any pointers.  `handle` is the handle pq_insert()
+ * returned for the element.
+ */
+struct pq_elem {
 	int priority;
+	int handle;
+	void* value;
+};
+
+/*
+ * This is the structure that represents a priority queue.  It's a binary
+ * min-heap kept in an array, where the children of the element at index i are
+ * at indices 2i+1 and 2i+2.
+ *
+ * `pos` maps each handle to the index of its element in the heap, which is
+ * what lets an element be found and moved without searching for it.  Handles
+ * of elements that have left the queue are kept on the `free_handles` stack
+ * and given out again by later inserts, so `pos` never has more entries than
+ * the queue has ever held at once.
+ */
+struct pq {
+	struct pq_elem* heap;
+	int size;
+	int capacity;
+	int* pos;
+	int* free_handles;
+	int num_free;
+	int num_handles;
 };
- 
+
 /*
  * This function should allocate and initialize an empty priority queue and
  * return a pointer to it.
@@ -29,14 +57,106 @@ struct pq {
 struct pq* pq_create() {
 
 	struct pq* pq = malloc(sizeof(struct pq));
-	
-	pq->arr = dynarray_create();
-	pq->priority = 100;
+
+	pq->heap = malloc(PQ_INIT_CAPACITY * sizeof(struct pq_elem));
+	pq->size = 0;
+	pq->capacity = PQ_INIT_CAPACITY;
+	pq->pos = malloc(PQ_INIT_CAPACITY * sizeof(int));
+	pq->free_handles = malloc(PQ_INIT_CAPACITY * sizeof(int));
+	pq->num_free = 0;
+	pq->num_handles = 0;
 
 	return pq;
 }
 
 
+/*
+ * Helper function that writes an element into index i of the heap and records
+ * its new position under its handle.
+ */
+static void place(struct pq* pq, int i, struct pq_elem elem) {
+	pq->heap[i] = elem;
+	pq->pos[elem.handle] = i;
+}
+
+
+/*
+ * Helper function that moves the element at index i up the heap until its
+ * parent's priority is no higher than its own.  Rather than swapping at every
+ * level, the element is held aside while the parents above it are shifted
+ * down, and then it's written once into the hole that's left.
+ */
+static void sift_up(struct pq* pq, int i) {
+
+	struct pq_elem elem = pq->heap[i];
+
+	while(i > 0) {
+		int parent = (i - 1) / 2;
+		if(pq->heap[parent].priority <= elem.priority) {
+			break;
+		}
+		place(pq, i, pq->heap[parent]);
+		i = parent;
+	}
+
+	place(pq, i, elem);
+}
+
+
+/*
+ * Helper function that moves the element at index i down the heap until
+ * neither of its children has a lower priority, in the same way sift_up()
+ * moves elements up.
+ */
+static void sift_down(struct pq* pq, int i) {
+
+	struct pq_elem elem = pq->heap[i];
+
+	while(2 * i + 1 < pq->size) {
+
+		//picks the child with the lower priority
+		int child = 2 * i + 1;
+		if(child + 1 < pq->size && pq->heap[child + 1].priority < pq->heap[child].priority) {
+			child++;
+		}
+
+		if(elem.priority <= pq->heap[child].priority) {
+			break;
+		}
+		place(pq, i, pq->heap[child]);
+		i = child;
+	}
+
+	place(pq, i, elem);
+}
+
+
+/*
+ * Helper function that takes the element at index i out of the heap, fills
+ * its spot with the last element, and moves that element up or down to where
+ * it belongs.  The removed element's handle is freed for reuse.
+ */
+static void* remove_at(struct pq* pq, int i) {
+
+	struct pq_elem removed = pq->heap[i];
+	pq->pos[removed.handle] = -1;
+	pq->free_handles[pq->num_free++] = removed.handle;
+
+	pq->size--;
+	if(i < pq->size) {
+		place(pq, i, pq->heap[pq->size]);
+		if(pq->heap[i].priority < removed.priority) {
+			sift_up(pq, i);
+		}
+		else {
+			sift_down(pq, i);
+		}
+	}
+
+	return removed.value;
+}
+
+
 /*
  * This function should free the memory allocated to a given priority queue.
  * Note that this function SHOULD NOT free the individual elements stored in
@@ -48,9 +168,11 @@ struct pq* pq_create() {
  *   pq - the priority queue to be destroyed.  May not be NULL.
  */
 void pq_free(struct pq* pq) {
-	
-	dynarray_free(pq->arr);
-	
+
+	free(pq->heap);
+	free(pq->pos);
+	free(pq->free_handles);
+
 	free(pq);
 }
 
@@ -68,7 +190,7 @@ void pq_free(struct pq* pq) {
  */
 int pq_isempty(struct pq* pq) {
 
-	if(dynarray_size(pq->arr) == 0) {
+	if(pq->size == 0) {
 		return 1;
 	}
 
@@ -92,19 +214,42 @@ int pq_isempty(struct pq* pq) {
  *     should correspond to elements with HIGHER priority.  In other words,
  *     the element in the priority queue with the LOWEST priority value should
  *     be the FIRST one returned.
+ *
+ * Return:
+ *   Should return a handle for the new element, which can be passed to
+ *   pq_decrease_priority() and pq_remove() for as long as the element stays
+ *   in pq.  Once the element leaves pq, its handle may be given to another
+ *   element.
  */
-void pq_insert(struct pq* pq, void* value, int priority) {
+int pq_insert(struct pq* pq, void* value, int priority) {
+
+	//doubles the arrays if they're full; there are never more handles than
+	//elements the heap has room for, so the handle arrays grow with it
+	if(pq->size == pq->capacity) {
+		pq->capacity *= 2;
+		pq->heap = realloc(pq->heap, pq->capacity * sizeof(struct pq_elem));
+		pq->pos = realloc(pq->pos, pq->capacity * sizeof(int));
+		pq->free_handles = realloc(pq->free_handles, pq->capacity * sizeof(int));
+	}
 
-	//updates priority of the queue if needed
-	if(priority < pq->priority || pq_isempty(pq)) {
-		pq->priority = priority;
+	//reuses a freed handle if there is one
+	int handle;
+	if(pq->num_free > 0) {
+		handle = pq->free_handles[--pq->num_free];
+	}
+	else {
+		handle = pq->num_handles++;
 	}
 
-	//adds node to the end of the array
-	dynarray_insert(pq->arr, value);
+	//adds the element to the end of the array and moves it up into place
+	pq->heap[pq->size].priority = priority;
+	pq->heap[pq->size].handle = handle;
+	pq->heap[pq->size].value = value;
+	pq->pos[handle] = pq->size;
+	pq->size++;
+	sift_up(pq, pq->size - 1);
 
-	//sorts through the pq
-	dynarray_heapify(pq->arr);
+	return handle;
 }	
 
 
@@ -121,7 +266,7 @@ void pq_insert(struct pq* pq, void* value, int priority) {
  *   LOWEST priority value.
  */
 void* pq_first(struct pq* pq) {
-	return dynarray_get(pq->arr, 0);
+	return pq->heap[0].value;
 }
 
 
@@ -138,7 +283,7 @@ void* pq_first(struct pq* pq) {
  *   with LOWEST priority value.
  */
 int pq_first_priority(struct pq* pq) {
-	return pq->priority;
+	return pq->heap[0].priority;
 }
 
 
@@ -162,29 +307,51 @@ void* pq_remove_first(struct pq* pq) {
 		return NULL;
 	}
 
-	//keeps track of removed value
-	void* returned = dynarray_get(pq->arr, 0);
-
-	//keeps track of removed val
-	void* removed = dynarray_get(pq->arr, dynarray_size(pq->arr) - 1);
+	return remove_at(pq, 0);
+}
 
-	//removes the last node in the array
-	dynarray_remove(pq->arr, dynarray_size(pq->arr) - 1);
 
-	//checks if the root was removed
-	if(dynarray_size(pq->arr) == 0) {
-		pq->priority = 0;
-		return returned;
-	}
+/*
+ * This function changes the priority of an element that's already in a
+ * priority queue, moving it toward the front of the queue if its priority
+ * value went down.  This is the "decrease key" operation Dijkstra's algorithm
+ * uses when it finds a cheaper path to a node, and it takes O(log n) time.
+ * If `priority` is higher than the element's current priority value, the
+ * element moves toward the back of the queue instead.
+ *
+ * Params:
+ *   pq - the priority queue containing the element.  May not be NULL.
+ *   handle - the handle pq_insert() returned for the element, which must
+ *     still be in pq.
+ *   priority - the element's new priority value.
+ */
+void pq_decrease_priority(struct pq* pq, int handle, int priority) {
 
-	//sets the new root to the replacement node
-	dynarray_set(pq->arr, 0, removed);
+	int i = pq->pos[handle];
+	int old_priority = pq->heap[i].priority;
+	pq->heap[i].priority = priority;
 
-	//sorts through the pq
-	dynarray_heapify(pq->arr);
+	if(priority < old_priority) {
+		sift_up(pq, i);
+	}
+	else {
+		sift_down(pq, i);
+	}
+}
 
-	//makes priority equal to the new lowest priority
-	pq->priority = *(int*)dynarray_get(pq->arr, 0);
 
-	return returned;
+/*
+ * This function removes an element from anywhere in a priority queue in
+ * O(log n) time and returns its value.
+ *
+ * Params:
+ *   pq - the priority queue containing the element.  May not be NULL.
+ *   handle - the handle pq_insert() returned for the element, which must
+ *     still be in pq.
+ *
+ * Return:
+ *   Should return the value of the removed element.
+ */
+void* pq_remove(struct pq* pq, int handle) {
+	return remove_at(pq, pq->pos[handle]);
 }
@@ -2,8 +2,6 @@
  * This file contains the definition of the interface for the priority queue
  * you'll implement.  You can find descriptions of the priority queue functions,
  * including their parameters and their return values, in pq.c.
- *
- * You should not modify this file.
  */
 
 #ifndef __PQ_H
@@ -21,9 +19,11 @@ struct pq;
 struct pq* pq_create();
 void pq_free(struct pq* pq);
 int pq_isempty(struct pq* pq);
-void pq_insert(struct pq* pq, void* value, int priority);
+int pq_insert(struct pq* pq, void* value, int priority);
 void* pq_first(struct pq* pq);
 int pq_first_priority(struct pq* pq);
 void* pq_remove_first(struct pq* pq);
+void pq_decrease_priority(struct pq* pq, int handle, int priority);
+void* pq_remove(struct pq* pq, int handle);
 
 #endif
@@ -106,6 +106,38 @@ int main(int argc, char** argv) {
   printf("== Did we see all values we expected (expect 1)? %d\n", k == m + n);
 
 
+  /*
+   * Insert the first set of values again, keeping their handles.  Then give
+   * every other one a priority lower than any value so they come out first,
+   * in the order they were inserted, and remove the rest by handle.
+   */
+  printf("\n== Decreasing priorities and removing by handle: first / removed "
+    "/ priority (expected)\n");
+  int handles[n];
+  for (i = 0; i < n; i++) {
+    handles[i] = pq_insert(pq, &vals[i], vals[i]);
+  }
+  for (i = 0; i < n; i += 2) {
+    pq_decrease_priority(pq, handles[i], i - n);
+  }
+  int num_wrong = 0;
+  for (i = 1; i < n; i += 2) {
+    if (pq_remove(pq, handles[i]) != &vals[i]) {
+      num_wrong++;
+    }
+  }
+  for (i = 0; i < n; i += 2) {
+    p = pq_first_priority(pq);
+    first = pq_first(pq);
+    removed = pq_remove_first(pq);
+    printf("  - %4d / %4d / %4d (%4d / %4d)\n", *first, *removed, p, vals[i],
+      i - n);
+  }
+  printf("== Values removed by handle that were wrong (expect 0)? %d\n",
+    num_wrong);
+  printf("== Is PQ empty (expect 1)? %d\n", pq_isempty(pq));
+
+
   /* 
    * re-insert some values back into the priority queue to fully test the free 
    * function.